@@ -53,6 +53,13 @@ class AggregateQuery {
   // when the tests and mocking are removed.
   virtual void GetAggregate(AggregateQueryCallback&& callback);
 
+  /**
+   * Computes the aggregations over the documents in the local cache, without
+   * contacting the backend. Documents that the cache doesn't have are not
+   * counted.
+   */
+  void GetAggregateFromCache(AggregateQueryCallback&& callback);
+
   // TODO(b/280805906) Remove this count specific API after the c++ SDK migrates
   // to the new Aggregate API Backward-compatible getter for count result
   void Get(CountQueryCallback&& callback);
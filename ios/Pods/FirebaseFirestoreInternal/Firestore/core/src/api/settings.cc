@@ -36,7 +36,11 @@ Settings::Settings(const Settings& other)
     : host_(other.host_),
       ssl_enabled_(other.ssl_enabled_),
       persistence_enabled_(other.persistence_enabled_),
-      cache_size_bytes_(other.cache_size_bytes_) {
+      cache_size_bytes_(other.cache_size_bytes_),
+      approximate_lru_sequence_numbers_(
+          other.approximate_lru_sequence_numbers_),
+      coalesce_writes_(other.coalesce_writes_),
+      adaptive_write_pipeline_(other.adaptive_write_pipeline_) {
   if (other.cache_settings_ != nullptr) {
     cache_settings_ = CopyCacheSettings(*other.cache_settings_);
   }
@@ -51,6 +55,9 @@ Settings& Settings::operator=(const Settings& other) {
   ssl_enabled_ = other.ssl_enabled_;
   persistence_enabled_ = other.persistence_enabled_;
   cache_size_bytes_ = other.cache_size_bytes_;
+  approximate_lru_sequence_numbers_ = other.approximate_lru_sequence_numbers_;
+  coalesce_writes_ = other.coalesce_writes_;
+  adaptive_write_pipeline_ = other.adaptive_write_pipeline_;
   if (other.cache_settings_ != nullptr) {
     cache_settings_ = CopyCacheSettings(*other.cache_settings_);
   }
@@ -115,13 +122,19 @@ MemoryCacheSettings MemoryCacheSettings::WithMemoryGarbageCollectorSettings(
 
 size_t Settings::Hash() const {
   return util::Hash(host_, ssl_enabled_, persistence_enabled_,
-                    cache_size_bytes_, cache_settings_);
+                    cache_size_bytes_, cache_settings_,
+                    approximate_lru_sequence_numbers_, coalesce_writes_,
+                    adaptive_write_pipeline_);
 }
 
 bool operator==(const Settings& lhs, const Settings& rhs) {
   bool eq = lhs.host_ == rhs.host_ && lhs.ssl_enabled_ == rhs.ssl_enabled_ &&
             lhs.persistence_enabled_ == rhs.persistence_enabled_ &&
-            lhs.cache_size_bytes_ == rhs.cache_size_bytes_;
+            lhs.cache_size_bytes_ == rhs.cache_size_bytes_ &&
+            lhs.approximate_lru_sequence_numbers_ ==
+                rhs.approximate_lru_sequence_numbers_ &&
+            lhs.coalesce_writes_ == rhs.coalesce_writes_ &&
+            lhs.adaptive_write_pipeline_ == rhs.adaptive_write_pipeline_;
   if (!eq) {
     return eq;
   }
@@ -78,6 +78,41 @@ class Settings {
   const LocalCacheSettings* local_cache_settings() const;
   void set_local_cache_settings(const LocalCacheSettings& settings);
 
+  /**
+   * Experimental: lets LRU garbage collection of the persistent cache
+   * estimate sequence number percentiles from a sketch instead of
+   * enumerating every orphaned document on each run. Off by default.
+   */
+  void set_approximate_lru_sequence_numbers(bool value) {
+    approximate_lru_sequence_numbers_ = value;
+  }
+  bool approximate_lru_sequence_numbers() const {
+    return approximate_lru_sequence_numbers_;
+  }
+
+  /**
+   * Experimental: lets consecutive pending writes that touch distinct
+   * documents share a write request. The backend commits each request
+   * atomically, so such writes succeed or fail together. Off by default.
+   */
+  void set_coalesce_writes(bool value) {
+    coalesce_writes_ = value;
+  }
+  bool coalesce_writes() const {
+    return coalesce_writes_;
+  }
+
+  /**
+   * Experimental: lets the number of writes in flight adapt to the observed
+   * round-trip time instead of staying at 10. Off by default.
+   */
+  void set_adaptive_write_pipeline(bool value) {
+    adaptive_write_pipeline_ = value;
+  }
+  bool adaptive_write_pipeline() const {
+    return adaptive_write_pipeline_;
+  }
+
   friend bool operator==(const Settings& lhs, const Settings& rhs);
 
   size_t Hash() const;
@@ -91,6 +126,9 @@ class Settings {
   bool persistence_enabled_ = DefaultPersistenceEnabled;
   int64_t cache_size_bytes_ = DefaultCacheSizeBytes;
   std::unique_ptr<LocalCacheSettings> cache_settings_ = nullptr;
+  bool approximate_lru_sequence_numbers_ = false;
+  bool coalesce_writes_ = false;
+  bool adaptive_write_pipeline_ = false;
 };
 
 class LocalCacheSettings {
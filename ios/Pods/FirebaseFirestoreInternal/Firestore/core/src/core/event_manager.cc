@@ -16,6 +16,7 @@
 
 #include "Firestore/core/src/core/event_manager.h"
 
+#include <algorithm>
 #include <utility>
 
 #include "Firestore/core/src/core/query_listener.h"
@@ -27,13 +28,23 @@ namespace firebase {
 namespace firestore {
 namespace core {
 
+namespace chr = std::chrono;
+
+using util::AsyncQueue;
 using util::Empty;
+using util::TimerId;
 
-EventManager::EventManager(QueryEventSource* query_event_source)
-    : query_event_source_(query_event_source) {
+EventManager::EventManager(QueryEventSource* query_event_source,
+                           std::shared_ptr<AsyncQueue> worker_queue)
+    : query_event_source_(query_event_source),
+      worker_queue_(std::move(worker_queue)) {
   query_event_source->SetCallback(this);
 }
 
+EventManager::~EventManager() {
+  snapshot_delivery_timer_.Cancel();
+}
+
 model::TargetId EventManager::AddQueryListener(
     std::shared_ptr<core::QueryListener> listener) {
   const Query& query = listener->query();
@@ -185,6 +196,54 @@ void EventManager::OnViewSnapshots(
   if (raised_event) {
     RaiseSnapshotsInSyncEvent();
   }
+  ScheduleSnapshotDelivery();
+}
+
+void EventManager::ScheduleSnapshotDelivery() {
+  absl::optional<chr::steady_clock::time_point> deadline;
+  for (const auto& kv : queries_) {
+    for (const auto& listener : kv.second.listeners) {
+      auto listener_deadline = listener->pending_snapshot_deadline();
+      if (listener_deadline && (!deadline || *listener_deadline < *deadline)) {
+        deadline = listener_deadline;
+      }
+    }
+  }
+  if (!deadline || (snapshot_delivery_deadline_ &&
+                    *snapshot_delivery_deadline_ <= *deadline)) {
+    return;
+  }
+
+  // Round up, so that the deadline has passed by the time the timer fires.
+  auto delay = chr::duration_cast<AsyncQueue::Milliseconds>(
+                   std::max(*deadline - chr::steady_clock::now(),
+                            chr::steady_clock::duration::zero())) +
+               AsyncQueue::Milliseconds(1);
+
+  snapshot_delivery_timer_.Cancel();
+  snapshot_delivery_deadline_ = deadline;
+  snapshot_delivery_timer_ = worker_queue_->EnqueueAfterDelay(
+      delay, TimerId::SnapshotDelivery, [this] {
+        snapshot_delivery_deadline_ = absl::nullopt;
+        RaisePendingSnapshots();
+      });
+}
+
+void EventManager::RaisePendingSnapshots() {
+  auto now = chr::steady_clock::now();
+  bool raised_event = false;
+  for (const auto& kv : queries_) {
+    for (const auto& listener : kv.second.listeners) {
+      auto deadline = listener->pending_snapshot_deadline();
+      if (deadline && *deadline <= now && listener->RaisePendingSnapshot()) {
+        raised_event = true;
+      }
+    }
+  }
+  if (raised_event) {
+    RaiseSnapshotsInSyncEvent();
+  }
+  ScheduleSnapshotDelivery();
 }
 
 void EventManager::OnError(const core::Query& query,
@@ -17,6 +17,7 @@
 #ifndef FIRESTORE_CORE_SRC_CORE_EVENT_MANAGER_H_
 #define FIRESTORE_CORE_SRC_CORE_EVENT_MANAGER_H_
 
+#include <chrono>
 #include <memory>
 #include <unordered_map>
 #include <unordered_set>
@@ -27,7 +28,9 @@
 #include "Firestore/core/src/core/sync_engine_callback.h"
 #include "Firestore/core/src/core/view_snapshot.h"
 #include "Firestore/core/src/model/model_fwd.h"
+#include "Firestore/core/src/util/async_queue.h"
 #include "Firestore/core/src/util/empty.h"
+#include "Firestore/core/src/util/executor.h"
 #include "Firestore/core/src/util/status_fwd.h"
 #include "absl/types/optional.h"
 
@@ -44,7 +47,14 @@ class QueryEventSource;
  */
 class EventManager : public SyncEngineCallback {
  public:
-  explicit EventManager(QueryEventSource* query_event_source_);
+  /**
+   * Creates an EventManager for the given source. Snapshots held back by a
+   * listener's minimum snapshot interval are raised on `worker_queue`.
+   */
+  EventManager(QueryEventSource* query_event_source_,
+               std::shared_ptr<util::AsyncQueue> worker_queue);
+
+  ~EventManager() override;
 
   /**
    * Adds a query listener that will be called with new snapshots for the query.
@@ -79,6 +89,15 @@ class EventManager : public SyncEngineCallback {
    */
   void RaiseSnapshotsInSyncEvent();
 
+  /**
+   * Schedules `RaisePendingSnapshots` for when the earliest snapshot held back
+   * by a listener is due, unless it is already scheduled by then.
+   */
+  void ScheduleSnapshotDelivery();
+
+  /** Raises the held back snapshots that are due, and reschedules. */
+  void RaisePendingSnapshots();
+
   /**
    * Holds the listeners and the last received ViewSnapshot for a query being
    * tracked by EventManager.
@@ -131,6 +150,11 @@ class EventManager : public SyncEngineCallback {
   std::unordered_map<core::Query, QueryListenersInfo> queries_;
   std::unordered_set<std::shared_ptr<EventListener<util::Empty>>>
       snapshots_in_sync_listeners_;
+
+  std::shared_ptr<util::AsyncQueue> worker_queue_;
+  util::DelayedOperation snapshot_delivery_timer_;
+  absl::optional<std::chrono::steady_clock::time_point>
+      snapshot_delivery_deadline_;
 };
 
 }  // namespace core
@@ -207,8 +207,11 @@ void FirestoreClient::Initialize(const User& user, const Settings& settings) {
   if (settings.persistence_enabled()) {
     LevelDbOpener opener(database_info_);
 
-    auto created =
-        opener.Create(LruParams::WithCacheSize(settings.cache_size_bytes()));
+    LruParams lru_params =
+        LruParams::WithCacheSize(settings.cache_size_bytes());
+    lru_params.approximate_sequence_numbers =
+        settings.approximate_lru_sequence_numbers();
+    auto created = opener.Create(lru_params);
     // If leveldb fails to start then just throw up our hands: the error is
     // unrecoverable. There's nothing an end-user can do and nearly all
     // failures indicate the developer is doing something grossly wrong so we
@@ -260,10 +263,14 @@ void FirestoreClient::Initialize(const User& user, const Settings& settings) {
       absl::make_unique<SyncEngine>(local_store_.get(), remote_store_.get(),
                                     user, kMaxConcurrentLimboResolutions);
 
-  event_manager_ = absl::make_unique<EventManager>(sync_engine_.get());
+  event_manager_ =
+      absl::make_unique<EventManager>(sync_engine_.get(), worker_queue_);
 
   // Setup wiring for remote store.
   remote_store_->set_sync_engine(sync_engine_.get());
+  remote_store_->set_coalesce_writes(settings.coalesce_writes());
+  remote_store_->set_adaptive_write_pipeline(
+      settings.adaptive_write_pipeline());
 
   // NOTE: RemoteStore depends on LocalStore (for persisting stream tokens,
   // refilling mutation queue, etc.) so must be started after LocalStore.
@@ -575,6 +582,25 @@ void FirestoreClient::RunAggregateQuery(
   });
 }
 
+void FirestoreClient::RunAggregateQueryFromLocalCache(
+    const Query& query,
+    const std::vector<AggregateField>& aggregates,
+    api::AggregateQueryCallback&& result_callback) {
+  VerifyNotTerminated();
+
+  // Dispatch the result back onto the user dispatch queue.
+  auto async_callback = [this,
+                         result_callback](const StatusOr<ObjectValue>& status) {
+    if (result_callback) {
+      user_executor_->Execute([=] { result_callback(std::move(status)); });
+    }
+  };
+
+  worker_queue_->Enqueue([this, query, aggregates, async_callback] {
+    async_callback(local_store_->ExecuteAggregateQuery(query, aggregates));
+  });
+}
+
 void FirestoreClient::AddSnapshotsInSyncListener(
     const std::shared_ptr<EventListener<Empty>>& user_listener) {
   worker_queue_->Enqueue([this, user_listener] {
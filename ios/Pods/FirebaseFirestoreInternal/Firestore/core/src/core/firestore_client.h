@@ -159,6 +159,15 @@ class FirestoreClient : public std::enable_shared_from_this<FirestoreClient> {
                          const std::vector<model::AggregateField>& aggregates,
                          api::AggregateQueryCallback&& result_callback);
 
+  /**
+   * Computes the aggregations over the documents in the cache that match the
+   * given query, without contacting the backend.
+   */
+  void RunAggregateQueryFromLocalCache(
+      const Query& query,
+      const std::vector<model::AggregateField>& aggregates,
+      api::AggregateQueryCallback&& result_callback);
+
   /**
    * Adds a listener to be called when a snapshots-in-sync event fires.
    */
@@ -17,6 +17,7 @@
 #ifndef FIRESTORE_CORE_SRC_CORE_LISTEN_OPTIONS_H_
 #define FIRESTORE_CORE_SRC_CORE_LISTEN_OPTIONS_H_
 
+#include <chrono>
 #include <utility>
 #include "Firestore/core/src/api/listen_source.h"
 namespace firebase {
@@ -120,11 +121,32 @@ class ListenOptions {
     return source_;
   }
 
+  /**
+   * The minimum time between two events raised for the listener, or zero if
+   * events are raised as soon as they happen. Snapshots arriving within this
+   * interval of the last event are merged into the next one.
+   */
+  std::chrono::milliseconds min_snapshot_interval() const {
+    return min_snapshot_interval_;
+  }
+
+  /**
+   * Returns a copy of these options that raises events at most once every
+   * `interval`.
+   */
+  ListenOptions WithMinSnapshotInterval(
+      std::chrono::milliseconds interval) const {
+    ListenOptions result = *this;
+    result.min_snapshot_interval_ = interval;
+    return result;
+  }
+
  private:
   bool include_query_metadata_changes_ = false;
   bool include_document_metadata_changes_ = false;
   bool wait_for_sync_when_online_ = false;
   ListenSource source_ = ListenSource::Default;
+  std::chrono::milliseconds min_snapshot_interval_{0};
 };
 
 }  // namespace core
@@ -32,6 +32,8 @@ using model::OnlineState;
 using model::TargetId;
 using util::Status;
 
+using Clock = std::chrono::steady_clock;
+
 std::shared_ptr<QueryListener> QueryListener::Create(
     Query query, ListenOptions options, ViewSnapshotSharedListener&& listener) {
   return std::make_shared<QueryListener>(std::move(query), std::move(options),
@@ -98,15 +100,70 @@ bool QueryListener::OnViewSnapshot(ViewSnapshot snapshot) {
       RaiseInitialEvent(snapshot);
       raised_event = true;
     }
+  } else if (pending_snapshot_) {
+    // Keep the held back snapshot current, even with snapshots that would not
+    // have raised an event on their own.
+    DelayEvent(snapshot, ShouldRaiseEvent(snapshot));
   } else if (ShouldRaiseEvent(snapshot)) {
-    listener_->OnEvent(snapshot);
-    raised_event = true;
+    if (ShouldDelayEvent()) {
+      DelayEvent(snapshot, /*would_raise=*/true);
+    } else {
+      RaiseEvent(snapshot);
+      raised_event = true;
+    }
   }
 
   snapshot_ = std::move(snapshot);
   return raised_event;
 }
 
+absl::optional<Clock::time_point> QueryListener::pending_snapshot_deadline()
+    const {
+  if (!pending_snapshot_) {
+    return absl::nullopt;
+  }
+  return *last_raised_at_ + options_.min_snapshot_interval();
+}
+
+bool QueryListener::RaisePendingSnapshot() {
+  if (!pending_snapshot_) {
+    return false;
+  }
+
+  const ViewSnapshot& last = *pending_snapshot_;
+  ViewSnapshot merged{last.query(),
+                      last.documents(),
+                      last.old_documents(),
+                      pending_changes_.GetChanges(),
+                      last.mutated_keys(),
+                      last.from_cache(),
+                      last.sync_state_changed(),
+                      last.excludes_metadata_changes(),
+                      last.has_cached_results()};
+  size_t merged_count = pending_snapshot_count_;
+  pending_snapshot_.reset();
+  pending_changes_ = DocumentViewChangeSet{};
+  pending_snapshot_count_ = 0;
+
+  // Changes to the same documents may have cancelled each other out, leaving
+  // nothing that `ShouldRaiseEvent` would have raised on its own.
+  bool has_pending_writes_changed =
+      last_raised_has_pending_writes_ != merged.has_pending_writes();
+  if (merged.document_changes().empty() &&
+      !((merged.sync_state_changed() || has_pending_writes_changed) &&
+        options_.include_query_metadata_changes())) {
+    dropped_snapshot_count_ += merged_count;
+    return false;
+  }
+
+  if (merged_count > 1) {
+    ++coalesced_snapshot_count_;
+    dropped_snapshot_count_ += merged_count - 1;
+  }
+  RaiseEvent(merged);
+  return true;
+}
+
 void QueryListener::OnError(Status error) {
   listener_->OnEvent(std::move(error));
 }
@@ -189,7 +246,56 @@ void QueryListener::RaiseInitialEvent(const ViewSnapshot& snapshot) {
       snapshot.from_cache(), snapshot.excludes_metadata_changes(),
       snapshot.has_cached_results());
   raised_initial_event_ = true;
-  listener_->OnEvent(std::move(modified_snapshot));
+  RaiseEvent(modified_snapshot);
+}
+
+void QueryListener::RaiseEvent(const ViewSnapshot& snapshot) {
+  last_raised_at_ = Clock::now();
+  last_raised_has_pending_writes_ = snapshot.has_pending_writes();
+  listener_->OnEvent(snapshot);
+}
+
+bool QueryListener::ShouldDelayEvent() const {
+  if (options_.min_snapshot_interval() <= Clock::duration::zero() ||
+      !last_raised_at_) {
+    return false;
+  }
+  return Clock::now() - *last_raised_at_ < options_.min_snapshot_interval();
+}
+
+void QueryListener::DelayEvent(const ViewSnapshot& snapshot, bool would_raise) {
+  for (const DocumentViewChange& change : snapshot.document_changes()) {
+    pending_changes_.AddChange(DocumentViewChange{change});
+  }
+
+  if (pending_snapshot_) {
+    // The merged snapshot starts from the documents the first one started
+    // from, and changes sync state if any of the merged ones did.
+    pending_snapshot_ = ViewSnapshot{
+        snapshot.query(),
+        snapshot.documents(),
+        pending_snapshot_->old_documents(),
+        {},
+        snapshot.mutated_keys(),
+        snapshot.from_cache(),
+        pending_snapshot_->sync_state_changed() ||
+            snapshot.sync_state_changed(),
+        snapshot.excludes_metadata_changes(),
+        snapshot.has_cached_results()};
+  } else {
+    pending_snapshot_ = ViewSnapshot{snapshot.query(),
+                                     snapshot.documents(),
+                                     snapshot.old_documents(),
+                                     {},
+                                     snapshot.mutated_keys(),
+                                     snapshot.from_cache(),
+                                     snapshot.sync_state_changed(),
+                                     snapshot.excludes_metadata_changes(),
+                                     snapshot.has_cached_results()};
+  }
+  if (would_raise) {
+    ++pending_snapshot_count_;
+  }
 }
 
 }  // namespace core
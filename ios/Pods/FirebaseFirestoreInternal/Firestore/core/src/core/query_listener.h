@@ -17,6 +17,7 @@
 #ifndef FIRESTORE_CORE_SRC_CORE_QUERY_LISTENER_H_
 #define FIRESTORE_CORE_SRC_CORE_QUERY_LISTENER_H_
 
+#include <chrono>
 #include <memory>
 #include <utility>
 
@@ -85,11 +86,51 @@ class QueryListener {
   /** Returns whether a snapshot was raised. */
   virtual bool OnOnlineStateChanged(model::OnlineState online_state);
 
+  /**
+   * Returns the time at which the snapshot held back by the minimum snapshot
+   * interval should be raised, or nullopt if there is none.
+   */
+  absl::optional<std::chrono::steady_clock::time_point>
+  pending_snapshot_deadline() const;
+
+  /**
+   * Raises the snapshot held back by the minimum snapshot interval, if there
+   * is one. Returns true if a user-facing event was raised.
+   */
+  bool RaisePendingSnapshot();
+
+  /** The number of raised events that merged more than one snapshot. */
+  size_t coalesced_snapshot_count() const {
+    return coalesced_snapshot_count_;
+  }
+
+  /**
+   * The number of snapshots that were merged into a later one instead of being
+   * raised on their own.
+   */
+  size_t dropped_snapshot_count() const {
+    return dropped_snapshot_count_;
+  }
+
  private:
   bool ShouldRaiseInitialEvent(const ViewSnapshot& snapshot,
                                model::OnlineState online_state) const;
   bool ShouldRaiseEvent(const ViewSnapshot& snapshot) const;
   void RaiseInitialEvent(const ViewSnapshot& snapshot);
+  void RaiseEvent(const ViewSnapshot& snapshot);
+
+  /**
+   * Returns true if a snapshot arriving now is within the minimum snapshot
+   * interval of the last raised event and must be held back.
+   */
+  bool ShouldDelayEvent() const;
+
+  /**
+   * Merges `snapshot` into the snapshot held back for the next event.
+   * `would_raise` tells whether `snapshot` would have raised an event of its
+   * own, for the coalescing counters.
+   */
+  void DelayEvent(const ViewSnapshot& snapshot, bool would_raise);
 
   Query query_;
   ListenOptions options_;
@@ -111,6 +152,23 @@ class QueryListener {
   model::OnlineState online_state_ = model::OnlineState::Unknown;
 
   absl::optional<ViewSnapshot> snapshot_;
+
+  /** When the last user-facing event was raised. */
+  absl::optional<std::chrono::steady_clock::time_point> last_raised_at_;
+
+  /** Whether the last raised snapshot had pending writes. */
+  bool last_raised_has_pending_writes_ = false;
+
+  /**
+   * The snapshot held back by the minimum snapshot interval, carrying the
+   * document changes of all the snapshots merged into it.
+   */
+  absl::optional<ViewSnapshot> pending_snapshot_;
+  DocumentViewChangeSet pending_changes_;
+  size_t pending_snapshot_count_ = 0;
+
+  size_t coalesced_snapshot_count_ = 0;
+  size_t dropped_snapshot_count_ = 0;
 };
 
 }  // namespace core
@@ -19,6 +19,7 @@
 #include "Firestore/core/src/local/leveldb_globals_cache.h"
 #include "Firestore/core/src/local/leveldb_key.h"
 #include "Firestore/core/src/local/leveldb_persistence.h"
+#include "absl/strings/numbers.h"
 
 namespace firebase {
 namespace firestore {
@@ -27,6 +28,7 @@ namespace local {
 namespace {
 
 const char* kSessionToken = "session_token";
+const char* kByteSizeEstimate = "byte_size_estimate";
 
 }
 
@@ -52,6 +54,25 @@ void LevelDbGlobalsCache::SetSessionToken(const ByteString& session_token) {
   db_->current_transaction()->Put(key, session_token.ToString());
 }
 
+absl::optional<int64_t> LevelDbGlobalsCache::GetByteSizeEstimate() const {
+  auto key = LevelDbGlobalKey::Key(kByteSizeEstimate);
+
+  std::string encoded;
+  auto done = db_->current_transaction()->Get(key, &encoded);
+
+  int64_t byte_size = 0;
+  if (!done.ok() || !absl::SimpleAtoi(encoded, &byte_size)) {
+    return absl::nullopt;
+  }
+
+  return byte_size;
+}
+
+void LevelDbGlobalsCache::SetByteSizeEstimate(int64_t byte_size) {
+  auto key = LevelDbGlobalKey::Key(kByteSizeEstimate);
+  db_->current_transaction()->Put(key, std::to_string(byte_size));
+}
+
 }  // namespace local
 }  // namespace firestore
 }  // namespace firebase
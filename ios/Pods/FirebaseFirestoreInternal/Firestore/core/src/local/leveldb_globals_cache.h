@@ -17,7 +17,10 @@
 #ifndef FIRESTORE_CORE_SRC_LOCAL_LEVELDB_GLOBALS_CACHE_H_
 #define FIRESTORE_CORE_SRC_LOCAL_LEVELDB_GLOBALS_CACHE_H_
 
+#include <cstdint>
+
 #include "Firestore/core/src/local/globals_cache.h"
+#include "absl/types/optional.h"
 
 namespace firebase {
 namespace firestore {
@@ -40,6 +43,17 @@ class LevelDbGlobalsCache : public GlobalsCache {
    */
   void SetSessionToken(const ByteString& session_token) override;
 
+  /**
+   * Gets the last persisted estimate of the size of the database in bytes,
+   * or nullopt if none has been persisted yet.
+   */
+  absl::optional<int64_t> GetByteSizeEstimate() const;
+
+  /**
+   * Persists an estimate of the size of the database in bytes.
+   */
+  void SetByteSizeEstimate(int64_t byte_size);
+
  private:
   // The LevelDbGlobalsCache is owned by LevelDbPersistence.
   LevelDbPersistence* db_ = nullptr;
@@ -283,6 +283,83 @@ class LevelDbDocumentMutationKey {
   model::BatchId batch_id_ = model::kBatchIdUnknown;
 };
 
+/**
+ * A key in the collection_mutations table, an index of the mutation batches
+ * that affect the immediate children of each collection.
+ *
+ * Since the batch_id follows the collection path, the rows for a collection's
+ * immediate children sort ahead of those for any of its subcollections, so a
+ * scan for one collection can stop at the first row for a deeper path.
+ */
+class LevelDbCollectionMutationKey {
+ public:
+  /**
+   * Creates a key prefix that points just before the first key in the table.
+   */
+  static std::string KeyPrefix();
+
+  /**
+   * Creates a key prefix that points just before the first key for the given
+   * user_id.
+   */
+  static std::string KeyPrefix(absl::string_view user_id);
+
+  /**
+   * Creates a key prefix that points just before the first key for the user_id
+   * and collection.
+   *
+   * A prefix scan over this key also finds the rows of subcollections, after
+   * those of the collection itself; compare `collection()` to tell them apart.
+   */
+  static std::string KeyPrefix(absl::string_view user_id,
+                               const model::ResourcePath& collection);
+
+  /**
+   * Creates a complete key that points to a specific user_id, document key,
+   * and batch_id.
+   */
+  static std::string Key(absl::string_view user_id,
+                         const model::DocumentKey& document_key,
+                         model::BatchId batch_id);
+
+  /**
+   * Decodes the given complete key, storing the decoded values in this
+   * instance.
+   *
+   * @return true if the key successfully decoded, false otherwise. If false is
+   * returned, this instance is in an undefined state until the next call to
+   * `Decode()`.
+   */
+  ABSL_MUST_USE_RESULT
+  bool Decode(absl::string_view key);
+
+  /** The user that owns the mutation batches. */
+  const std::string& user_id() const {
+    return user_id_;
+  }
+
+  /** The collection containing the document, as encoded in the key. */
+  const model::ResourcePath& collection() const {
+    return collection_;
+  }
+
+  /** The batch_id in which the document participates. */
+  model::BatchId batch_id() const {
+    return batch_id_;
+  }
+
+  /** The ID of the document within the collection. */
+  const std::string& document_id() const {
+    return document_id_;
+  }
+
+ private:
+  std::string user_id_;
+  model::ResourcePath collection_;
+  model::BatchId batch_id_ = model::kBatchIdUnknown;
+  std::string document_id_;
+};
+
 /**
  * A key in the mutation_queues table.
  *
@@ -67,12 +67,12 @@ void LevelDbLruReferenceDelegate::AddReference(const DocumentKey& key) {
 }
 
 void LevelDbLruReferenceDelegate::RemoveReference(const DocumentKey& key) {
-  WriteSentinel(key);
+  UpdateSentinel(key);
 }
 
 void LevelDbLruReferenceDelegate::RemoveMutationReference(
     const DocumentKey& key) {
-  WriteSentinel(key);
+  UpdateSentinel(key);
 }
 
 void LevelDbLruReferenceDelegate::RemoveTarget(const TargetData& target_data) {
@@ -82,7 +82,27 @@ void LevelDbLruReferenceDelegate::RemoveTarget(const TargetData& target_data) {
 }
 
 void LevelDbLruReferenceDelegate::UpdateLimboDocument(const DocumentKey& key) {
-  WriteSentinel(key);
+  UpdateSentinel(key);
+}
+
+void LevelDbLruReferenceDelegate::OnTargetsRemoved(const DocumentKey& key) {
+  if (gc_->tracks_orphaned_documents() &&
+      !db_->target_cache()->Contains(key)) {
+    ListenSequenceNumber sequence_number = ReadSentinel(key);
+    if (sequence_number != kListenSequenceNumberInvalid) {
+      gc_->OnDocumentOrphaned(sequence_number);
+    }
+  }
+}
+
+void LevelDbLruReferenceDelegate::OnTargetAdded(const DocumentKey& key) {
+  if (gc_->tracks_orphaned_documents() &&
+      !db_->target_cache()->Contains(key)) {
+    ListenSequenceNumber sequence_number = ReadSentinel(key);
+    if (sequence_number != kListenSequenceNumberInvalid) {
+      gc_->OnOrphanedDocumentGone(sequence_number);
+    }
+  }
 }
 
 ListenSequenceNumber LevelDbLruReferenceDelegate::current_sequence_number()
@@ -110,6 +130,10 @@ StatusOr<int64_t> LevelDbLruReferenceDelegate::CalculateByteSize() {
   return db_->CalculateByteSize();
 }
 
+StatusOr<int64_t> LevelDbLruReferenceDelegate::EstimateByteSize() {
+  return db_->EstimateByteSize();
+}
+
 size_t LevelDbLruReferenceDelegate::GetSequenceNumberCount() {
   size_t total_count = db_->target_cache()->size();
   EnumerateOrphanedDocuments(
@@ -139,6 +163,7 @@ int LevelDbLruReferenceDelegate::RemoveOrphanedDocuments(
             count++;
             db_->remote_document_cache()->Remove(key);
             RemoveSentinel(key);
+            gc_->OnOrphanedDocumentGone(sequence_number);
           }
         }
       });
@@ -182,6 +207,28 @@ void LevelDbLruReferenceDelegate::RemoveSentinel(const DocumentKey& key) {
       LevelDbDocumentTargetKey::SentinelKey(key));
 }
 
+ListenSequenceNumber LevelDbLruReferenceDelegate::ReadSentinel(
+    const DocumentKey& key) {
+  std::string value;
+  leveldb::Status status = db_->current_transaction()->Get(
+      LevelDbDocumentTargetKey::SentinelKey(key), &value);
+  if (!status.ok()) {
+    return kListenSequenceNumberInvalid;
+  }
+  return LevelDbDocumentTargetKey::DecodeSentinelValue(value);
+}
+
+void LevelDbLruReferenceDelegate::UpdateSentinel(const DocumentKey& key) {
+  if (!gc_->tracks_orphaned_documents() ||
+      db_->target_cache()->Contains(key)) {
+    WriteSentinel(key);
+    return;
+  }
+  ListenSequenceNumber previous = ReadSentinel(key);
+  WriteSentinel(key);
+  gc_->OnOrphanedDocumentUpdated(previous, current_sequence_number());
+}
+
 void LevelDbLruReferenceDelegate::WriteSentinel(const DocumentKey& key) {
   std::string sentinel_key = LevelDbDocumentTargetKey::SentinelKey(key);
   std::string encoded_sequence_number =
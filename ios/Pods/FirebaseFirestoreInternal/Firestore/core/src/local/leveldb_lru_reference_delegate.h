@@ -53,11 +53,22 @@ class LevelDbLruReferenceDelegate : public LruDelegate {
   void OnTransactionStarted(absl::string_view label) override;
   void OnTransactionCommitted() override;
 
+  /**
+   * Called by the target cache after removing the given document from one or
+   * more targets it was in, and before adding it to one. Keeps the garbage collector's
+   * view of which documents are orphaned current.
+   */
+  void OnTargetsRemoved(const model::DocumentKey& key);
+  void OnTargetAdded(const model::DocumentKey& key);
+
   // MARK: LruDelegate methods
 
   LruGarbageCollector* garbage_collector() override;
 
   util::StatusOr<int64_t> CalculateByteSize() override;
+
+  util::StatusOr<int64_t> EstimateByteSize() override;
+
   size_t GetSequenceNumberCount() override;
 
   void EnumerateTargetSequenceNumbers(
@@ -75,6 +86,10 @@ class LevelDbLruReferenceDelegate : public LruDelegate {
   bool MutationQueuesContainKey(const model::DocumentKey& key);
 
   void RemoveSentinel(const model::DocumentKey& key);
+  /** Returns kListenSequenceNumberInvalid if the document has no sentinel. */
+  model::ListenSequenceNumber ReadSentinel(const model::DocumentKey& key);
+  /** WriteSentinel, reporting the change if the document is orphaned. */
+  void UpdateSentinel(const model::DocumentKey& key);
   void WriteSentinel(const model::DocumentKey& key);
 
   std::unique_ptr<LruGarbageCollector> gc_;
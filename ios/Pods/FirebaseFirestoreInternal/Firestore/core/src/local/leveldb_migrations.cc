@@ -370,6 +370,37 @@ void EnsureOverlayDataMigrationIsRequired(leveldb::DB* db) {
   transaction.Commit();
 }
 
+/**
+ * Migration 9.
+ *
+ * Creates LevelDbCollectionMutationKey rows for all existing entries in the
+ * document-mutation index. Any rows left behind by a downgraded client, which
+ * would not have maintained the index, are dropped first.
+ */
+void EnsureCollectionMutationsIndex(leveldb::DB* db) {
+  DeleteEverythingWithPrefix(LevelDbCollectionMutationKey::KeyPrefix(), db);
+
+  LevelDbTransaction transaction(db, "Ensure Collection Mutations Index");
+
+  std::string mutations_prefix = LevelDbDocumentMutationKey::KeyPrefix();
+  auto it = transaction.NewIterator();
+  it->Seek(mutations_prefix);
+  LevelDbDocumentMutationKey key;
+  std::string empty_buffer;
+  for (; it->Valid() && absl::StartsWith(it->key(), mutations_prefix);
+       it->Next()) {
+    HARD_ASSERT(key.Decode(it->key()),
+                "Failed to decode document-mutation key");
+
+    transaction.Put(LevelDbCollectionMutationKey::Key(
+                        key.user_id(), key.document_key(), key.batch_id()),
+                    empty_buffer);
+  }
+
+  SaveVersion(9, &transaction);
+  transaction.Commit();
+}
+
 }  // namespace
 
 LevelDbMigrations::SchemaVersion LevelDbMigrations::ReadSchemaVersion(
@@ -433,6 +464,10 @@ void LevelDbMigrations::RunMigrations(leveldb::DB* db,
   if (from_version < 8 && to_version >= 8) {
     EnsureOverlayDataMigrationIsRequired(db);
   }
+
+  if (from_version < 9 && to_version >= 9) {
+    EnsureCollectionMutationsIndex(db);
+  }
 }
 
 }  // namespace local
@@ -179,6 +179,9 @@ MutationBatch LevelDbMutationQueue::AddMutationBatch(
     key = LevelDbDocumentMutationKey::Key(user_id_, mutation.key(), batch_id);
     db_->current_transaction()->Put(key, empty_buffer);
 
+    key = LevelDbCollectionMutationKey::Key(user_id_, mutation.key(), batch_id);
+    db_->current_transaction()->Put(key, empty_buffer);
+
     index_manager_->AddToCollectionParentIndex(mutation.key().path().PopLast());
   }
 
@@ -206,6 +209,8 @@ void LevelDbMutationQueue::RemoveMutationBatch(const MutationBatch& batch) {
   for (const Mutation& mutation : batch.mutations()) {
     key = LevelDbDocumentMutationKey::Key(user_id_, mutation.key(), batch_id);
     db_->current_transaction()->Delete(key);
+    key = LevelDbCollectionMutationKey::Key(user_id_, mutation.key(), batch_id);
+    db_->current_transaction()->Delete(key);
     db_->reference_delegate()->RemoveMutationReference(mutation.key());
   }
 }
@@ -276,56 +281,35 @@ LevelDbMutationQueue::AllMutationBatchesAffectingQuery(const Query& query) {
       "CollectionGroup queries should be handled in LocalDocumentsView");
 
   const ResourcePath& query_path = query.path();
-  size_t immediate_children_path_length = query_path.size() + 1;
 
-  // TODO(mcg): Actually implement a single-collection query
+  // Scan the collection-mutation index, which holds a row for each batch that
+  // affects an immediate child of the collection. Rows for subcollections sort
+  // after these, so the scan stops at the first of them rather than walking
+  // the whole subtree below the collection.
   //
-  // This is actually executing an ancestor query, traversing the whole subtree
-  // below the collection which can be horrifically inefficient for some
-  // structures. The right way to solve this is to implement the full value
-  // index, but that's not in the cards in the near future so this is the best
-  // we can do for the moment.
+  // Since we don't index the actual properties in the mutations, this returns
+  // all mutation batches that affect documents in the collection being
+  // queried, whether or not they touch the query's filters: a mutation that
+  // leaves the filtered fields alone still changes the contents of any
+  // matching document.
   //
-  // Since we don't yet index the actual properties in the mutations, our
-  // current approach is to just return all mutation batches that affect
-  // documents in the collection being queried.
-  //
-  // Unlike AllMutationBatchesAffectingDocumentKey, this iteration will scan the
-  // document-mutation index for more than a single document so the associated
-  // batch_ids will be neither necessarily unique nor in order. This means an
-  // efficient simultaneous scan isn't possible.
+  // The rows are ordered by batch_id but a batch can affect many documents in
+  // the collection, so collect the unique batch_ids in a set<BatchId> and then
+  // traverse them in order in a scan of the main table.
   std::string index_prefix =
-      LevelDbDocumentMutationKey::KeyPrefix(user_id_, query_path);
+      LevelDbCollectionMutationKey::KeyPrefix(user_id_, query_path);
   auto index_iterator = db_->current_transaction()->NewIterator();
   index_iterator->Seek(index_prefix);
 
-  LevelDbDocumentMutationKey row_key;
-
-  // Collect up unique batch_ids encountered during a scan of the index. Use a
-  // set<BatchId> to accumulate the IDs so they can be traversed in order in a
-  // scan of the main table.
-  //
-  // This method is faster than performing lookups of the keys with _db->Get and
-  // keeping a hash of batch_ids that have already been looked up. The
-  // performance difference is minor for small numbers of keys but > 30% faster
-  // for larger numbers of keys.
+  LevelDbCollectionMutationKey row_key;
   std::set<BatchId> unique_batch_ids;
   for (; index_iterator->Valid(); index_iterator->Next()) {
     if (!absl::StartsWith(index_iterator->key(), index_prefix) ||
-        !row_key.Decode(index_iterator->key())) {
+        !row_key.Decode(index_iterator->key()) ||
+        row_key.collection() != query_path) {
       break;
     }
 
-    // Rows with document keys more than one segment longer than the query path
-    // can't be matches. For example, a query on 'rooms' can't match the
-    // document /rooms/abc/messages/xyx.
-    // TODO(mcg): we'll need a different scanner when we implement ancestor
-    // queries.
-    if (row_key.document_key().path().size() !=
-        immediate_children_path_length) {
-      continue;
-    }
-
     unique_batch_ids.insert(row_key.batch_id());
   }
 
@@ -397,21 +381,24 @@ void LevelDbMutationQueue::PerformConsistencyCheck() {
     return;
   }
 
-  // Verify that there are no entries in the document-mutation index if the
-  // queue is empty.
-  std::string index_prefix = LevelDbDocumentMutationKey::KeyPrefix(user_id_);
-  auto index_iterator = db_->current_transaction()->NewIterator();
-  index_iterator->Seek(index_prefix);
-
+  // Verify that there are no entries in the document-mutation or
+  // collection-mutation indexes if the queue is empty.
   std::vector<std::string> dangling_mutation_references;
 
-  for (; index_iterator->Valid(); index_iterator->Next()) {
-    // Only consider rows matching this index prefix for the current user.
-    if (!absl::StartsWith(index_iterator->key(), index_prefix)) {
-      break;
-    }
+  for (const std::string& index_prefix :
+       {LevelDbDocumentMutationKey::KeyPrefix(user_id_),
+        LevelDbCollectionMutationKey::KeyPrefix(user_id_)}) {
+    auto index_iterator = db_->current_transaction()->NewIterator();
+    index_iterator->Seek(index_prefix);
 
-    dangling_mutation_references.push_back(DescribeKey(index_iterator));
+    for (; index_iterator->Valid(); index_iterator->Next()) {
+      // Only consider rows matching this index prefix for the current user.
+      if (!absl::StartsWith(index_iterator->key(), index_prefix)) {
+        break;
+      }
+
+      dangling_mutation_references.push_back(DescribeKey(index_iterator));
+    }
   }
 
   HARD_ASSERT(dangling_mutation_references.empty(),
@@ -154,6 +154,8 @@ Status LevelDbPersistence::EnsureDirectory(const Path& dir) {
 StatusOr<std::unique_ptr<DB>> LevelDbPersistence::OpenDb(const Path& dir) {
   leveldb::Options options;
   options.create_if_missing = true;
+  // data_block_hash_index stays off: older SDK builds can't read tables
+  // written with it, so enabling it would break downgrades.
 
   DB* database = nullptr;
   leveldb::Status status = DB::Open(options, dir.ToUtf8String(), &database);
@@ -218,9 +220,43 @@ StatusOr<int64_t> LevelDbPersistence::CalculateByteSize() {
     return Status::FromCause("Failed to iterate over LevelDB files",
                              iter->status());
   }
+
+  byte_size_estimate_ = static_cast<int64_t>(count);
+  byte_size_estimate_loaded_ = true;
+  estimates_since_reconciliation_ = 0;
   return static_cast<int64_t>(count);
 }
 
+StatusOr<int64_t> LevelDbPersistence::EstimateByteSize() {
+  LoadByteSizeEstimate();
+  if (!byte_size_estimate_ ||
+      ++estimates_since_reconciliation_ >= kByteSizeReconciliationInterval) {
+    return CalculateByteSize();
+  }
+  return *byte_size_estimate_;
+}
+
+void LevelDbPersistence::LoadByteSizeEstimate() {
+  if (byte_size_estimate_loaded_ || transaction_ == nullptr) {
+    return;
+  }
+  byte_size_estimate_ = globals_cache_->GetByteSizeEstimate();
+  persisted_byte_size_estimate_ = byte_size_estimate_;
+  byte_size_estimate_loaded_ = true;
+}
+
+void LevelDbPersistence::UpdateByteSizeEstimate() {
+  if (!byte_size_estimate_) {
+    return;
+  }
+  *byte_size_estimate_ +=
+      static_cast<int64_t>(transaction_->ApproximateByteSize());
+  if (byte_size_estimate_ != persisted_byte_size_estimate_) {
+    globals_cache_->SetByteSizeEstimate(*byte_size_estimate_);
+    persisted_byte_size_estimate_ = byte_size_estimate_;
+  }
+}
+
 // MARK: - Persistence
 
 model::ListenSequenceNumber LevelDbPersistence::current_sequence_number()
@@ -329,11 +365,13 @@ void LevelDbPersistence::RunInternal(absl::string_view label,
               "Starting a transaction while one is already in progress");
 
   transaction_ = absl::make_unique<LevelDbTransaction>(db_.get(), label);
+  LoadByteSizeEstimate();
   reference_delegate_->OnTransactionStarted(label);
 
   block();
 
   reference_delegate_->OnTransactionCommitted();
+  UpdateByteSizeEstimate();
   transaction_->Commit();
   transaction_.reset();
 }
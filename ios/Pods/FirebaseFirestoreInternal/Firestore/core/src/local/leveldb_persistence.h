@@ -38,6 +38,7 @@
 #include "Firestore/core/src/local/persistence.h"
 #include "Firestore/core/src/util/path.h"
 #include "Firestore/core/src/util/statusor.h"
+#include "absl/types/optional.h"
 
 namespace firebase {
 namespace firestore {
@@ -75,8 +76,23 @@ class LevelDbPersistence : public Persistence {
 
   static util::Status ClearPersistence(const core::DatabaseInfo& database_info);
 
+  /**
+   * Measures the size of the database by summing the sizes of the files in
+   * its directory, and resets the running estimate returned by
+   * EstimateByteSize() to the result.
+   */
   util::StatusOr<int64_t> CalculateByteSize();
 
+  /**
+   * Returns an estimate of CalculateByteSize() without touching the
+   * filesystem: the size last measured plus the bytes committed since, kept
+   * in the globals cache across restarts. Since LevelDB compacts away
+   * overwritten and deleted entries the estimate tends to run high; it is
+   * reconciled with a full CalculateByteSize() when no estimate is known and
+   * every `kByteSizeReconciliationInterval` calls.
+   */
+  util::StatusOr<int64_t> EstimateByteSize();
+
   // MARK: Persistence overrides
 
   model::ListenSequenceNumber current_sequence_number() const override;
@@ -125,6 +141,12 @@ class LevelDbPersistence : public Persistence {
    */
   static const size_t kMaxOperationPerTransaction = 1000U;
 
+  /**
+   * The number of calls to EstimateByteSize() between reconciliations with
+   * the actual size of the database directory.
+   */
+  static const int kByteSizeReconciliationInterval = 12;
+
   /**
    * Ensures that the given directory exists.
    */
@@ -149,6 +171,18 @@ class LevelDbPersistence : public Persistence {
   void DeleteEverythingWithPrefix(absl::string_view label,
                                   const std::string& prefix);
 
+  /**
+   * Reads the persisted byte size estimate, once, using the current
+   * transaction.
+   */
+  void LoadByteSizeEstimate();
+
+  /**
+   * Adds the bytes written by the current transaction to the byte size
+   * estimate and schedules the result to be persisted with it.
+   */
+  void UpdateByteSizeEstimate();
+
   std::unique_ptr<leveldb::DB> db_;
 
   util::Path directory_;
@@ -172,6 +206,11 @@ class LevelDbPersistence : public Persistence {
   std::unique_ptr<LevelDbLruReferenceDelegate> reference_delegate_;
 
   std::unique_ptr<LevelDbTransaction> transaction_;
+
+  absl::optional<int64_t> byte_size_estimate_;
+  absl::optional<int64_t> persisted_byte_size_estimate_;
+  bool byte_size_estimate_loaded_ = false;
+  int estimates_since_reconciliation_ = 0;
 };
 
 /** Returns a standard set of read options. */
@@ -18,7 +18,9 @@
 
 #include <string>
 #include <thread>
+#include <unordered_set>
 #include <utility>
+#include <vector>
 
 #include "Firestore/Protos/nanopb/firestore/local/maybe_document.nanopb.h"
 #include "Firestore/core/src/core/query.h"
@@ -89,6 +91,28 @@ class AsyncResults {
   std::mutex mutex_;
 };
 
+/**
+ * Returns the top-level field names that `query.Matches()` reads, or an empty
+ * set if the query has no filters and so rarely rejects documents on their
+ * contents.
+ */
+std::unordered_set<std::string> ProjectedFieldNames(const Query& query) {
+  std::unordered_set<std::string> field_names;
+  if (query.filters().empty()) {
+    return field_names;
+  }
+  for (const core::Filter& filter : query.filters()) {
+    for (const core::FieldFilter& field_filter :
+         filter.GetFlattenedFilters()) {
+      field_names.insert(field_filter.field().first_segment());
+    }
+  }
+  for (const core::OrderBy& order_by : query.normalized_order_bys()) {
+    field_names.insert(order_by.field().first_segment());
+  }
+  return field_names;
+}
+
 }  // namespace
 
 LevelDbRemoteDocumentCache::LevelDbRemoteDocumentCache(
@@ -147,21 +171,78 @@ MutableDocumentMap LevelDbRemoteDocumentCache::GetAll(
   BackgroundQueue tasks(executor_.get());
   AsyncResults<std::pair<DocumentKey, MutableDocument>> results;
 
-  LevelDbRemoteDocumentKey current_key;
-  auto it = db_->current_transaction()->NewIterator();
+  std::vector<std::string> ldb_keys;
+  ldb_keys.reserve(keys.size());
+  for (const DocumentKey& key : keys) {
+    ldb_keys.push_back(LevelDbRemoteDocumentKey::Key(key));
+  }
+  std::vector<std::string> contents;
+  std::vector<Status> statuses =
+      db_->current_transaction()->MultiGet(ldb_keys, &contents);
 
+  size_t i = 0;
   for (const DocumentKey& key : keys) {
-    it->Seek(LevelDbRemoteDocumentKey::Key(key));
-    if (!it->Valid() || !current_key.Decode(it->key()) ||
-        current_key.document_key() != key) {
+    const Status& status = statuses[i];
+    if (status.IsNotFound()) {
       results.Insert(
           std::make_pair(key, MutableDocument::InvalidDocument(key)));
+    } else if (status.ok()) {
+      const std::string& encoded = contents[i];
+      tasks.Execute([this, &results, &key, &encoded] {
+        results.Insert(std::make_pair(key, DecodeMaybeDocument(encoded, key)));
+      });
     } else {
-      const std::string& contents = it->value();
-      tasks.Execute([this, &results, &key, contents] {
-        results.Insert(std::make_pair(key, DecodeMaybeDocument(contents, key)));
+      HARD_FAIL("Fetch document for key (%s) failed with status: %s",
+                key.ToString(), status.ToString());
+    }
+    ++i;
+  }
+
+  tasks.AwaitAll();
+
+  MutableDocumentMap map;
+  for (const auto& entry : results.Result()) {
+    map = map.insert(entry.first, entry.second);
+  }
+  return map;
+}
+
+MutableDocumentMap LevelDbRemoteDocumentCache::GetAllProjected(
+    const DocumentKeySet& keys,
+    const std::unordered_set<std::string>& field_names) const {
+  BackgroundQueue tasks(executor_.get());
+  AsyncResults<std::pair<DocumentKey, MutableDocument>> results;
+
+  std::vector<std::string> ldb_keys;
+  ldb_keys.reserve(keys.size());
+  for (const DocumentKey& key : keys) {
+    ldb_keys.push_back(LevelDbRemoteDocumentKey::Key(key));
+  }
+  std::vector<std::string> contents;
+  std::vector<Status> statuses =
+      db_->current_transaction()->MultiGet(ldb_keys, &contents);
+
+  size_t i = 0;
+  for (const DocumentKey& key : keys) {
+    const Status& status = statuses[i];
+    if (status.IsNotFound()) {
+      results.Insert(
+          std::make_pair(key, MutableDocument::InvalidDocument(key)));
+    } else if (status.ok()) {
+      const std::string& encoded = contents[i];
+      tasks.Execute([this, &results, &key, &encoded, &field_names] {
+        absl::optional<MutableDocument> projection =
+            serializer_->DecodeMaybeDocumentProjection(encoded, key,
+                                                       field_names);
+        results.Insert(std::make_pair(
+            key, projection ? *std::move(projection)
+                            : DecodeMaybeDocument(encoded, key)));
       });
+    } else {
+      HARD_FAIL("Fetch document for key (%s) failed with status: %s",
+                key.ToString(), status.ToString());
     }
+    ++i;
   }
 
   tasks.AwaitAll();
@@ -173,19 +254,82 @@ MutableDocumentMap LevelDbRemoteDocumentCache::GetAll(
   return map;
 }
 
+DocumentKeySet LevelDbRemoteDocumentCache::GetFoundKeys(
+    const DocumentKeySet& keys) const {
+  std::vector<std::string> ldb_keys;
+  ldb_keys.reserve(keys.size());
+  for (const DocumentKey& key : keys) {
+    ldb_keys.push_back(LevelDbRemoteDocumentKey::Key(key));
+  }
+  std::vector<std::string> contents;
+  std::vector<Status> statuses =
+      db_->current_transaction()->MultiGet(ldb_keys, &contents);
+
+  // With no field names the projection only reads the document type.
+  const std::unordered_set<std::string> no_fields;
+  DocumentKeySet found;
+  size_t i = 0;
+  for (const DocumentKey& key : keys) {
+    const Status& status = statuses[i];
+    if (status.ok()) {
+      absl::optional<MutableDocument> projection =
+          serializer_->DecodeMaybeDocumentProjection(contents[i], key,
+                                                     no_fields);
+      if (projection ? projection->is_found_document()
+                     : DecodeMaybeDocument(contents[i], key)
+                           .is_found_document()) {
+        found = found.insert(key);
+      }
+    } else if (!status.IsNotFound()) {
+      HARD_FAIL("Fetch document for key (%s) failed with status: %s",
+                key.ToString(), status.ToString());
+    }
+    ++i;
+  }
+  return found;
+}
+
 MutableDocumentMap LevelDbRemoteDocumentCache::GetAllExisting(
     DocumentVersionMap&& remote_map,
     const core::Query& query,
     const model::OverlayByDocumentKeyMap& mutated_docs) const {
+  // Filtering usually needs only a few fields of each document, so decode
+  // just those first and skip the full decode for documents that the query
+  // rejects.
+  std::unordered_set<std::string> field_names = ProjectedFieldNames(query);
+
   BackgroundQueue tasks(executor_.get());
   AsyncResults<std::pair<DocumentKey, MutableDocument>> results;
   for (const auto& key_version : remote_map) {
-    tasks.Execute([this, &results, &key_version, query, &mutated_docs] {
-      auto document = Get(key_version.first).WithReadTime(key_version.second);
+    tasks.Execute([this, &results, &key_version, query, &mutated_docs,
+                   &field_names] {
+      const DocumentKey& key = key_version.first;
+      std::string encoded;
+      Status status = db_->current_transaction()->Get(
+          LevelDbRemoteDocumentKey::Key(key), &encoded);
+      if (status.IsNotFound()) {
+        return;
+      } else if (!status.ok()) {
+        HARD_FAIL("Fetch document for key (%s) failed with status: %s",
+                  key.ToString(), status.ToString());
+      }
+
+      bool is_mutated = mutated_docs.find(key) != mutated_docs.end();
+      if (!field_names.empty() && !is_mutated) {
+        absl::optional<MutableDocument> projection =
+            serializer_->DecodeMaybeDocumentProjection(encoded, key,
+                                                       field_names);
+        if (projection && (!projection->is_found_document() ||
+                           !query.Matches(*projection))) {
+          return;
+        }
+      }
+
+      auto document =
+          DecodeMaybeDocument(encoded, key).WithReadTime(key_version.second);
       if (document.is_found_document() &&
           // Either the document matches the given query, or it is mutated.
-          (query.Matches(document) ||
-           mutated_docs.find(key_version.first) != mutated_docs.end())) {
+          (query.Matches(document) || is_mutated)) {
         results.Insert(std::make_pair(key_version.first, std::move(document)));
       }
     });
@@ -20,6 +20,7 @@
 #include <memory>
 #include <string>
 #include <thread>
+#include <unordered_set>
 #include <vector>
 
 #include "Firestore/core/src/core/query.h"
@@ -62,6 +63,11 @@ class LevelDbRemoteDocumentCache : public RemoteDocumentCache {
   model::MutableDocument Get(const model::DocumentKey& key) const override;
   model::MutableDocumentMap GetAll(
       const model::DocumentKeySet& keys) const override;
+  model::MutableDocumentMap GetAllProjected(
+      const model::DocumentKeySet& keys,
+      const std::unordered_set<std::string>& field_names) const override;
+  model::DocumentKeySet GetFoundKeys(
+      const model::DocumentKeySet& keys) const override;
   model::MutableDocumentMap GetAll(const std::string& collection_group,
                                    const model::IndexOffset& offset,
                                    size_t limit) const override;
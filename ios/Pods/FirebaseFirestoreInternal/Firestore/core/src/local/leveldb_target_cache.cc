@@ -24,6 +24,7 @@
 #include "Firestore/core/src/local/leveldb_persistence.h"
 #include "Firestore/core/src/local/leveldb_util.h"
 #include "Firestore/core/src/local/local_serializer.h"
+#include "Firestore/core/src/local/lru_garbage_collector.h"
 #include "Firestore/core/src/local/reference_delegate.h"
 #include "Firestore/core/src/local/target_data.h"
 #include "Firestore/core/src/model/document_key.h"
@@ -133,11 +134,18 @@ void LevelDbTargetCache::RemoveTarget(const TargetData& target_data) {
       LevelDbQueryTargetKey::Key(target_data.target().CanonicalId(), target_id);
   db_->current_transaction()->Delete(index_key);
 
+  targets_.erase(target_data.target());
+
   metadata_->target_count--;
   SaveMetadata();
 }
 
 absl::optional<TargetData> LevelDbTargetCache::GetTarget(const Target& target) {
+  auto cached = targets_.find(target);
+  if (cached != targets_.end()) {
+    return cached->second;
+  }
+
   // Scan the query-target index starting with a prefix starting with the given
   // target's canonical_id. Note that this is a scan rather than a get because
   // canonical_ids are not required to be unique per target.
@@ -181,6 +189,7 @@ absl::optional<TargetData> LevelDbTargetCache::GetTarget(const Target& target) {
     // actually equal to the requested target.
     TargetData target_data = DecodeTarget(target_iterator->value());
     if (target_data.target() == target) {
+      targets_.emplace(target, target_data);
       return target_data;
     }
   }
@@ -235,6 +244,17 @@ size_t LevelDbTargetCache::RemoveTargets(
   // Remove the CanonicalId to TargetId mapping
   RemoveQueryTargetKeyForTargets(removed_targets);
 
+  if (!removed_targets.empty()) {
+    for (auto it = targets_.begin(); it != targets_.end();) {
+      if (removed_targets.find(it->second.target_id()) !=
+          removed_targets.end()) {
+        it = targets_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+
   metadata_->target_count -= removed_targets.size();
   SaveMetadata();
 
@@ -250,6 +270,7 @@ void LevelDbTargetCache::AddMatchingKeys(const DocumentKeySet& keys,
   std::string empty_buffer;
 
   for (const DocumentKey& key : keys) {
+    db_->reference_delegate()->OnTargetAdded(key);
     db_->current_transaction()->Put(
         LevelDbTargetDocumentKey::Key(target_id, key), empty_buffer);
     db_->current_transaction()->Put(
@@ -260,11 +281,24 @@ void LevelDbTargetCache::AddMatchingKeys(const DocumentKeySet& keys,
 
 void LevelDbTargetCache::RemoveMatchingKeys(const DocumentKeySet& keys,
                                             TargetId target_id) {
+  bool track_orphans = db_->reference_delegate()
+                           ->garbage_collector()
+                           ->tracks_orphaned_documents();
   for (const DocumentKey& key : keys) {
+    std::string document_target_key =
+        LevelDbDocumentTargetKey::Key(key, target_id);
+    // Only a key that was actually in the target can become orphaned here.
+    std::string unused;
+    bool was_in_target =
+        track_orphans &&
+        db_->current_transaction()->Get(document_target_key, &unused).ok();
+
     db_->current_transaction()->Delete(
         LevelDbTargetDocumentKey::Key(target_id, key));
-    db_->current_transaction()->Delete(
-        LevelDbDocumentTargetKey::Key(key, target_id));
+    db_->current_transaction()->Delete(document_target_key);
+    if (was_in_target) {
+      db_->reference_delegate()->OnTargetsRemoved(key);
+    }
     db_->reference_delegate()->RemoveReference(key);
   }
 }
@@ -288,6 +322,7 @@ void LevelDbTargetCache::RemoveMatchingKeysForTarget(TargetId target_id) {
     db_->current_transaction()->Delete(index_key);
     db_->current_transaction()->Delete(
         LevelDbDocumentTargetKey::Key(document_key, target_id));
+    db_->reference_delegate()->OnTargetsRemoved(document_key);
   }
 }
 
@@ -404,6 +439,14 @@ void LevelDbTargetCache::Save(const TargetData& target_data) {
   std::string key = LevelDbTargetKey::Key(target_id);
   db_->current_transaction()->Put(key,
                                   serializer_->EncodeTargetData(target_data));
+
+  // Cache exactly what `DecodeTarget` would return for this row: the purpose
+  // and expected count are not persisted.
+  targets_[target_data.target()] = TargetData(
+      target_data.target(), target_id, target_data.sequence_number(),
+      QueryPurpose::Listen, target_data.snapshot_version(),
+      target_data.last_limbo_free_snapshot_version(),
+      target_data.resume_token(), /*expected_count=*/absl::nullopt);
 }
 
 bool LevelDbTargetCache::UpdateMetadata(const TargetData& target_data) {
@@ -21,7 +21,9 @@
 #include <unordered_set>
 
 #include "Firestore/Protos/nanopb/firestore/local/target.nanopb.h"
+#include "Firestore/core/src/core/target.h"
 #include "Firestore/core/src/local/target_cache.h"
+#include "Firestore/core/src/local/target_data.h"
 #include "Firestore/core/src/model/model_fwd.h"
 #include "Firestore/core/src/model/snapshot_version.h"
 #include "Firestore/core/src/nanopb/message.h"
@@ -35,7 +37,6 @@ namespace local {
 
 class LevelDbPersistence;
 class LocalSerializer;
-class TargetData;
 
 /** Cached Queries backed by LevelDB. */
 class LevelDbTargetCache : public TargetCache {
@@ -152,6 +153,15 @@ class LevelDbTargetCache : public TargetCache {
   /** A write-through cached copy of the metadata for the target cache. */
   nanopb::Message<firestore_client_TargetGlobal> metadata_;
 
+  /**
+   * A write-through cache of decoded targets, keyed by `Target` (and so by its
+   * canonical id hash). It holds every target written through this cache and
+   * every target found by `GetTarget`, so repeated listens to the same query
+   * skip the index scan and the proto decode. Every write to the targets table
+   * goes through this class, so entries can never be stale.
+   */
+  std::unordered_map<core::Target, TargetData> targets_;
+
   model::SnapshotVersion last_remote_snapshot_version_;
 };
 
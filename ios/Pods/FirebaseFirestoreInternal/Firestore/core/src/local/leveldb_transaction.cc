@@ -155,6 +155,9 @@ const ReadOptions& LevelDbTransaction::DefaultReadOptions() {
   static ReadOptions options = [] {
     ReadOptions read_options;
     read_options.verify_checksums = true;
+    // Collection scans walk long contiguous key ranges; let leveldb read
+    // ahead once it sees an iterator moving through consecutive blocks.
+    read_options.readahead_blocks = 16;
     return read_options;
   }();
   return options;
@@ -194,6 +197,43 @@ Status LevelDbTransaction::Get(absl::string_view key, std::string* value) {
   }
 }
 
+std::vector<Status> LevelDbTransaction::MultiGet(
+    const std::vector<std::string>& keys, std::vector<std::string>* values) {
+  std::vector<Status> statuses(keys.size());
+  values->assign(keys.size(), std::string());
+
+  // Indexes into `keys` of the entries that have to be read from leveldb.
+  std::vector<size_t> db_indexes;
+  std::vector<Slice> db_keys;
+  for (size_t i = 0; i < keys.size(); ++i) {
+    const std::string& key = keys[i];
+    if (deletions_.find(key) != deletions_.end()) {
+      statuses[i] =
+          Status::NotFound(key + " is not present in the transaction");
+    } else {
+      Mutations::iterator iter{mutations_.find(key)};
+      if (iter != mutations_.end()) {
+        (*values)[i] = iter->second;
+      } else {
+        db_indexes.push_back(i);
+        db_keys.emplace_back(key);
+      }
+    }
+  }
+
+  if (!db_keys.empty()) {
+    std::vector<std::string> db_values;
+    std::vector<Status> db_statuses =
+        db_->MultiGet(read_options_, db_keys, &db_values);
+    for (size_t j = 0; j < db_indexes.size(); ++j) {
+      size_t i = db_indexes[j];
+      statuses[i] = std::move(db_statuses[j]);
+      (*values)[i] = std::move(db_values[j]);
+    }
+  }
+  return statuses;
+}
+
 void LevelDbTransaction::Delete(absl::string_view key) {
   std::string to_delete(key);
   deletions_.insert(to_delete);
@@ -201,6 +241,17 @@ void LevelDbTransaction::Delete(absl::string_view key) {
   version_++;
 }
 
+size_t LevelDbTransaction::ApproximateByteSize() const {
+  size_t bytes = 0;
+  for (const auto& deletion : deletions_) {
+    bytes += deletion.size();
+  }
+  for (const auto& entry : mutations_) {
+    bytes += entry.first.size() + entry.second.size();
+  }
+  return bytes;
+}
+
 void LevelDbTransaction::Commit() {
   WriteBatch batch;
   for (const auto& deletion : deletions_) {
@@ -23,6 +23,7 @@
 #include <set>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "Firestore/core/src/nanopb/byte_string.h"
 #include "Firestore/core/src/nanopb/message.h"
@@ -149,6 +150,13 @@ class LevelDbTransaction {
     return mutations_.size() + deletions_.size();
   }
 
+  /**
+   * Returns the approximate number of bytes that committing this transaction
+   * will write: the keys and values of all pending puts and the keys of all
+   * pending deletes.
+   */
+  size_t ApproximateByteSize() const;
+
   /**
    * Remove the database entry (if any) for "key".  It is not an error if "key"
    * did not exist in the database.
@@ -178,6 +186,15 @@ class LevelDbTransaction {
    */
   leveldb::Status Get(absl::string_view key, std::string* value);
 
+  /**
+   * Looks up each of `keys` as if by `Get`, storing the value for `keys[i]`
+   * in `(*values)[i]` and returning the statuses in the same order. Keys
+   * without pending changes are read from leveldb with a single batched
+   * `DB::MultiGet`.
+   */
+  std::vector<leveldb::Status> MultiGet(const std::vector<std::string>& keys,
+                                        std::vector<std::string>* values);
+
   /**
    * Returns a new Iterator over the pending changes in this transaction, merged
    * with the existing values already in leveldb.
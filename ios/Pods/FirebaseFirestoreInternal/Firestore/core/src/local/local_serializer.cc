@@ -16,11 +16,15 @@
 
 #include "Firestore/core/src/local/local_serializer.h"
 
+#include <pb_decode.h>
+
 #include <cstdlib>
 #include <limits>
 #include <memory>
 #include <string>
+#include <unordered_set>
 #include <utility>
+#include <vector>
 
 #include "Firestore/Protos/nanopb/firestore/bundle.nanopb.h"
 #include "Firestore/Protos/nanopb/firestore/local/maybe_document.nanopb.h"
@@ -55,6 +59,7 @@ using bundle::BundleMetadata;
 using bundle::NamedQuery;
 using core::Target;
 using model::DeepClone;
+using model::DocumentKey;
 using model::FieldPath;
 using model::FieldTransform;
 using model::MutableDocument;
@@ -135,6 +140,110 @@ MutableDocument LocalSerializer::DecodeMaybeDocument(
   UNREACHABLE();
 }
 
+absl::optional<MutableDocument> LocalSerializer::DecodeMaybeDocumentProjection(
+    absl::string_view encoded,
+    const DocumentKey& key,
+    const std::unordered_set<std::string>& field_names) const {
+  pb_istream_t stream = pb_istream_from_buffer(
+      reinterpret_cast<const pb_byte_t*>(encoded.data()), encoded.size());
+
+  bool is_found_document = false;
+  std::vector<google_firestore_v1_Document_FieldsEntry> entries;
+  auto fail = [&entries]() -> absl::optional<MutableDocument> {
+    for (auto& entry : entries) {
+      nanopb::FreeNanopbMessage(google_firestore_v1_Document_FieldsEntry_fields,
+                                &entry);
+    }
+    return absl::nullopt;
+  };
+
+  pb_wire_type_t wire_type;
+  uint32_t tag;
+  bool eof;
+  while (pb_decode_tag(&stream, &wire_type, &tag, &eof)) {
+    if (tag != firestore_client_MaybeDocument_document_tag ||
+        wire_type != PB_WT_STRING) {
+      if (tag == firestore_client_MaybeDocument_no_document_tag ||
+          tag == firestore_client_MaybeDocument_unknown_document_tag) {
+        is_found_document = false;
+      }
+      if (!pb_skip_field(&stream, wire_type)) return fail();
+      continue;
+    }
+
+    // The last member of the `document_type` oneof wins, as in `pb_decode`.
+    is_found_document = true;
+    for (auto& entry : entries) {
+      nanopb::FreeNanopbMessage(google_firestore_v1_Document_FieldsEntry_fields,
+                                &entry);
+    }
+    entries.clear();
+    if (field_names.empty()) {
+      // Only the document type was asked for.
+      if (!pb_skip_field(&stream, wire_type)) return fail();
+      continue;
+    }
+
+    pb_istream_t document;
+    if (!pb_make_string_substream(&stream, &document)) return fail();
+    while (pb_decode_tag(&document, &wire_type, &tag, &eof)) {
+      if (tag != google_firestore_v1_Document_fields_tag ||
+          wire_type != PB_WT_STRING) {
+        if (!pb_skip_field(&document, wire_type)) return fail();
+        continue;
+      }
+
+      pb_istream_t entry_stream;
+      if (!pb_make_string_substream(&document, &entry_stream)) return fail();
+      // Buffer streams can be rewound by copying them, so the entry is only
+      // decoded in full once its key turns out to be projected.
+      pb_istream_t entry_start = entry_stream;
+      bool projected = false;
+      while (pb_decode_tag(&entry_stream, &wire_type, &tag, &eof)) {
+        if (tag != google_firestore_v1_Document_FieldsEntry_key_tag ||
+            wire_type != PB_WT_STRING) {
+          if (!pb_skip_field(&entry_stream, wire_type)) return fail();
+          continue;
+        }
+        pb_istream_t key_stream;
+        if (!pb_make_string_substream(&entry_stream, &key_stream)) {
+          return fail();
+        }
+        std::string field_name(key_stream.bytes_left, '\0');
+        if (!pb_read(&key_stream, reinterpret_cast<pb_byte_t*>(&field_name[0]),
+                     field_name.size()) ||
+            !pb_close_string_substream(&entry_stream, &key_stream)) {
+          return fail();
+        }
+        projected = field_names.count(field_name) > 0;
+      }
+      if (!eof) return fail();
+
+      if (projected) {
+        google_firestore_v1_Document_FieldsEntry entry{};
+        if (!pb_decode(&entry_start,
+                       google_firestore_v1_Document_FieldsEntry_fields,
+                       &entry)) {
+          // `pb_decode` has already released anything it allocated.
+          return fail();
+        }
+        entries.push_back(entry);
+      }
+      if (!pb_close_string_substream(&document, &entry_stream)) return fail();
+    }
+    if (!eof || !pb_close_string_substream(&stream, &document)) return fail();
+  }
+  if (!eof) return fail();
+
+  if (!is_found_document) {
+    return MutableDocument::InvalidDocument(key);
+  }
+  ObjectValue fields = ObjectValue::FromFieldsEntry(
+      entries.data(), static_cast<pb_size_t>(entries.size()));
+  return MutableDocument::FoundDocument(key, SnapshotVersion::None(),
+                                        std::move(fields));
+}
+
 google_firestore_v1_Document LocalSerializer::EncodeDocument(
     const MutableDocument& doc) const {
   google_firestore_v1_Document result{};
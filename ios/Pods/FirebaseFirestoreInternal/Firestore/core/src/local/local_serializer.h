@@ -18,6 +18,8 @@
 #define FIRESTORE_CORE_SRC_LOCAL_LOCAL_SERIALIZER_H_
 
 #include <memory>
+#include <string>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -26,6 +28,8 @@
 #include "Firestore/core/src/model/types.h"
 #include "Firestore/core/src/remote/serializer.h"
 #include "Firestore/core/src/util/status_fwd.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
 
 namespace firebase {
 namespace firestore {
@@ -100,6 +104,25 @@ class LocalSerializer {
   model::MutableDocument DecodeMaybeDocument(
       nanopb::Reader* reader, firestore_client_MaybeDocument& proto) const;
 
+  /**
+   * Decodes only the top-level fields named in `field_names` from an encoded
+   * MaybeDocument proto, skipping over the encoded values of every other field
+   * without materializing them.
+   *
+   * The result is a found document with the given key, no version and just the
+   * projected fields, or an invalid document if `encoded` holds a deleted or
+   * unknown document. It is only meant for evaluating filters and orderings
+   * that read nothing outside `field_names`; documents that are returned to
+   * callers must still go through `DecodeMaybeDocument`.
+   *
+   * Returns an empty optional if `encoded` could not be parsed, in which case
+   * the caller should fall back to `DecodeMaybeDocument` to report the error.
+   */
+  absl::optional<model::MutableDocument> DecodeMaybeDocumentProjection(
+      absl::string_view encoded,
+      const model::DocumentKey& key,
+      const std::unordered_set<std::string>& field_names) const;
+
   /**
    * @brief Encodes a TargetData to the equivalent nanopb proto, representing a
    * ::firestore::proto::Target, for local storage.
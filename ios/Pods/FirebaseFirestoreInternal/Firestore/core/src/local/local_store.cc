@@ -53,6 +53,7 @@ using core::Query;
 using core::Target;
 using core::TargetIdGenerator;
 using credentials::User;
+using model::AggregateField;
 using model::BatchId;
 using model::Document;
 using model::DocumentKey;
@@ -573,6 +574,24 @@ QueryResult LocalStore::ExecuteQuery(const Query& query,
   });
 }
 
+ObjectValue LocalStore::ExecuteAggregateQuery(
+    const Query& query, const std::vector<AggregateField>& aggregates) {
+  return persistence_->Run("ExecuteAggregateQuery", [&] {
+    absl::optional<TargetData> target_data = GetTargetData(query.ToTarget());
+    SnapshotVersion last_limbo_free_snapshot_version;
+    DocumentKeySet remote_keys;
+
+    if (target_data) {
+      last_limbo_free_snapshot_version =
+          target_data->last_limbo_free_snapshot_version();
+      remote_keys = target_cache_->GetMatchingKeys(target_data->target_id());
+    }
+
+    return query_engine_->GetAggregates(
+        query, aggregates, last_limbo_free_snapshot_version, remote_keys);
+  });
+}
+
 DocumentKeySet LocalStore::GetRemoteDocumentKeys(TargetId target_id) {
   return persistence_->Run("RemoteDocumentKeysForTarget", [&] {
     return target_cache_->GetMatchingKeys(target_id);
@@ -30,6 +30,7 @@
 #include "Firestore/core/src/local/overlay_migration_manager.h"
 #include "Firestore/core/src/local/reference_set.h"
 #include "Firestore/core/src/local/target_data.h"
+#include "Firestore/core/src/model/aggregate_field.h"
 #include "Firestore/core/src/model/document.h"
 #include "Firestore/core/src/model/model_fwd.h"
 #include "absl/types/optional.h"
@@ -224,6 +225,15 @@ class LocalStore : public bundle::BundleCallback {
    */
   QueryResult ExecuteQuery(const core::Query& query, bool use_previous_results);
 
+  /**
+   * Computes the given aggregations over the documents in the local store that
+   * match the query, without contacting the backend. The result is keyed by
+   * alias, as returned by a RunAggregationQuery request.
+   */
+  model::ObjectValue ExecuteAggregateQuery(
+      const core::Query& query,
+      const std::vector<model::AggregateField>& aggregates);
+
   /**
    * Notify the local store of the changed views to locally pin / unpin
    * documents.
@@ -16,6 +16,7 @@
 
 #include "Firestore/core/src/local/lru_garbage_collector.h"
 
+#include <algorithm>
 #include <chrono>
 #include <queue>
 #include <string>
@@ -25,6 +26,7 @@
 #include "Firestore/core/src/api/settings.h"
 #include "Firestore/core/src/local/target_data.h"
 #include "Firestore/core/src/model/document_key.h"
+#include "Firestore/core/src/util/hard_assert.h"
 #include "Firestore/core/src/util/log.h"
 #include "Firestore/core/src/util/statusor.h"
 
@@ -105,6 +107,115 @@ LruParams LruParams::WithCacheSize(int64_t cache_size) {
   return params;
 }
 
+SequenceNumberSketch::SequenceNumberSketch(size_t max_buckets)
+    : max_buckets_(max_buckets) {
+  HARD_ASSERT(max_buckets_ > 0, "A sketch needs at least one bucket");
+}
+
+void SequenceNumberSketch::Add(ListenSequenceNumber sequence_number) {
+  buffer_.push_back(sequence_number);
+  count_++;
+  if (buffer_.size() >= max_buckets_) {
+    Flush();
+  }
+}
+
+void SequenceNumberSketch::Remove(ListenSequenceNumber sequence_number) {
+  // Prefer an exact match among the values not yet merged into buckets.
+  auto pending = std::find(buffer_.begin(), buffer_.end(), sequence_number);
+  if (pending != buffer_.end()) {
+    buffer_.erase(pending);
+    count_--;
+    return;
+  }
+
+  auto bucket = std::lower_bound(
+      buckets_.begin(), buckets_.end(), sequence_number,
+      [](const Bucket& b, ListenSequenceNumber value) {
+        return b.max < value;
+      });
+  if (bucket == buckets_.end() || bucket->min > sequence_number) {
+    return;
+  }
+  bucket->count--;
+  count_--;
+  if (bucket->count == 0) {
+    buckets_.erase(bucket);
+  }
+}
+
+void SequenceNumberSketch::Clear() {
+  buckets_.clear();
+  buffer_.clear();
+  count_ = 0;
+}
+
+ListenSequenceNumber SequenceNumberSketch::SequenceNumberForRank(
+    size_t n) const {
+  Flush();
+  if (buckets_.empty()) {
+    return kListenSequenceNumberInvalid;
+  }
+
+  size_t seen = 0;
+  for (const Bucket& bucket : buckets_) {
+    if (seen + bucket.count >= n) {
+      // Assume values spread evenly across the bucket.
+      double fraction = static_cast<double>(n - seen) / bucket.count;
+      return bucket.min + static_cast<ListenSequenceNumber>(
+                              (bucket.max - bucket.min) * fraction);
+    }
+    seen += bucket.count;
+  }
+  return buckets_.back().max;
+}
+
+void SequenceNumberSketch::Flush() const {
+  if (buffer_.empty()) {
+    return;
+  }
+  std::sort(buffer_.begin(), buffer_.end());
+
+  // Merge the sorted buffer into the sorted buckets, combining any that
+  // overlap.
+  std::vector<Bucket> merged;
+  merged.reserve(buckets_.size() + buffer_.size());
+  auto append = [&merged](const Bucket& bucket) {
+    if (!merged.empty() && merged.back().max >= bucket.min) {
+      merged.back().max = std::max(merged.back().max, bucket.max);
+      merged.back().count += bucket.count;
+    } else {
+      merged.push_back(bucket);
+    }
+  };
+  auto bucket = buckets_.begin();
+  auto value = buffer_.begin();
+  while (bucket != buckets_.end() || value != buffer_.end()) {
+    if (value != buffer_.end() &&
+        (bucket == buckets_.end() || *value < bucket->min)) {
+      append(Bucket{*value, *value, 1});
+      ++value;
+    } else {
+      append(*bucket);
+      ++bucket;
+    }
+  }
+  buffer_.clear();
+
+  // Combine adjacent buckets as long as each stays within its share of the
+  // values, which bounds the number of buckets by about max_buckets_.
+  size_t limit = std::max<size_t>(1, 2 * count_ / max_buckets_);
+  buckets_.clear();
+  for (const Bucket& next : merged) {
+    if (!buckets_.empty() && buckets_.back().count + next.count <= limit) {
+      buckets_.back().max = next.max;
+      buckets_.back().count += next.count;
+    } else {
+      buckets_.push_back(next);
+    }
+  }
+}
+
 LruGarbageCollector::LruGarbageCollector(LruDelegate* delegate,
                                          LruParams params)
     : delegate_(delegate), params_(std::move(params)) {
@@ -114,13 +225,24 @@ StatusOr<int64_t> LruGarbageCollector::CalculateByteSize() const {
   return delegate_->CalculateByteSize();
 }
 
+StatusOr<int64_t> LruGarbageCollector::EstimateByteSize() const {
+  return delegate_->EstimateByteSize();
+}
+
 LruResults LruGarbageCollector::Collect(const LiveQueryMap& live_targets) {
   if (params_.min_bytes_threshold == Settings::CacheSizeUnlimited) {
     LOG_DEBUG("Garbage collection skipped; disabled");
     return LruResults::DidNotRun();
   }
 
-  StatusOr<int64_t> maybe_current_size = CalculateByteSize();
+  // Most checks find the cache well under the threshold, which the estimate
+  // can tell without sizing the cache. Confirm with the exact size before
+  // collecting anything.
+  StatusOr<int64_t> maybe_current_size = EstimateByteSize();
+  if (maybe_current_size.ok() &&
+      maybe_current_size.ValueOrDie() >= params_.min_bytes_threshold) {
+    maybe_current_size = CalculateByteSize();
+  }
   if (!maybe_current_size.ok()) {
     LOG_ERROR(
         "Garbage collection skipped; failed to estimate the size of the "
@@ -145,6 +267,7 @@ LruResults LruGarbageCollector::Collect(const LiveQueryMap& live_targets) {
 LruResults LruGarbageCollector::RunGarbageCollection(
     const LiveQueryMap& live_targets) {
   Timestamp start = Timestamp::Now();
+  bool used_sketch = UseDocumentSketch();
 
   // Cap at the configured max
   int sequence_numbers = QueryCountForPercentile(params_.percentile_to_collect);
@@ -163,11 +286,15 @@ LruResults LruGarbageCollector::RunGarbageCollection(
   int num_documents_removed = RemoveOrphanedDocuments(upper_bound);
   Timestamp removed_documents = Timestamp::Now();
 
+  if (used_sketch) {
+    collections_since_sketch_rebuild_++;
+  }
+
   std::string desc = "LRU Garbage Collection:\n";
   absl::StrAppend(&desc, "\tCounted targets in ",
                   MillisecondsBetween(start, counted_targets), "ms\n");
   absl::StrAppend(&desc, "\tDetermined least recently used ", sequence_numbers,
-                  " sequence numbers in ",
+                  used_sketch ? " estimated" : "", " sequence numbers in ",
                   MillisecondsBetween(counted_targets, found_upper_bound),
                   "ms\n");
   absl::StrAppend(&desc, "\tRemoved ", num_targets_removed, " targets in ",
@@ -185,7 +312,14 @@ LruResults LruGarbageCollector::RunGarbageCollection(
 }
 
 int LruGarbageCollector::QueryCountForPercentile(int percentile) {
-  size_t total_count = delegate_->GetSequenceNumberCount();
+  size_t total_count = 0;
+  if (UseDocumentSketch()) {
+    total_count = document_sketch_.count();
+    delegate_->EnumerateTargetSequenceNumbers(
+        [&total_count](ListenSequenceNumber) { total_count++; });
+  } else {
+    total_count = delegate_->GetSequenceNumberCount();
+  }
   return static_cast<int>((percentile / 100.0f) * total_count);
 }
 
@@ -195,6 +329,10 @@ ListenSequenceNumber LruGarbageCollector::SequenceNumberForQueryCount(
     return kListenSequenceNumberInvalid;
   }
 
+  if (UseDocumentSketch()) {
+    return EstimateSequenceNumberForQueryCount(query_count);
+  }
+
   RollingSequenceNumberBuffer buffer(query_count);
 
   delegate_->EnumerateTargetSequenceNumbers(
@@ -202,14 +340,49 @@ ListenSequenceNumber LruGarbageCollector::SequenceNumberForQueryCount(
         buffer.AddElement(sequence_number);
       });
 
+  // Rebuild the sketch from the exact enumeration, which also drops any
+  // drift, e.g. from documents orphaned when GC removed their targets.
+  bool rebuild_sketch = params_.approximate_sequence_numbers;
+  ListenSequenceNumber estimate = kListenSequenceNumberInvalid;
+  if (rebuild_sketch) {
+    if (document_sketch_built_) {
+      estimate = EstimateSequenceNumberForQueryCount(query_count);
+    }
+    document_sketch_.Clear();
+  }
   delegate_->EnumerateOrphanedDocuments(
-      [&buffer](const DocumentKey&, ListenSequenceNumber sequence_number) {
+      [&](const DocumentKey&, ListenSequenceNumber sequence_number) {
         buffer.AddElement(sequence_number);
+        if (rebuild_sketch) {
+          document_sketch_.Add(sequence_number);
+        }
       });
+  if (rebuild_sketch) {
+    document_sketch_built_ = true;
+    collections_since_sketch_rebuild_ = 0;
+    if (estimate != kListenSequenceNumberInvalid) {
+      LOG_DEBUG(
+          "LRU Garbage Collection: sketch estimated sequence number %s for "
+          "%s sequence numbers, exact value is %s",
+          estimate, query_count, buffer.max_value());
+    }
+  }
 
   return buffer.max_value();
 }
 
+ListenSequenceNumber LruGarbageCollector::EstimateSequenceNumberForQueryCount(
+    int query_count) {
+  // Targets are few enough to enumerate; only orphaned documents come from
+  // the sketch.
+  SequenceNumberSketch sketch = document_sketch_;
+  delegate_->EnumerateTargetSequenceNumbers(
+      [&sketch](ListenSequenceNumber sequence_number) {
+        sketch.Add(sequence_number);
+      });
+  return sketch.SequenceNumberForRank(static_cast<size_t>(query_count));
+}
+
 int LruGarbageCollector::RemoveTargets(ListenSequenceNumber sequence_number,
                                        const LiveQueryMap& live_queries) {
   return delegate_->RemoveTargets(sequence_number, live_queries);
@@ -220,6 +393,37 @@ int LruGarbageCollector::RemoveOrphanedDocuments(
   return delegate_->RemoveOrphanedDocuments(sequence_number);
 }
 
+bool LruGarbageCollector::tracks_orphaned_documents() const {
+  return params_.approximate_sequence_numbers && document_sketch_built_;
+}
+
+void LruGarbageCollector::OnDocumentOrphaned(
+    ListenSequenceNumber sequence_number) {
+  if (tracks_orphaned_documents()) {
+    document_sketch_.Add(sequence_number);
+  }
+}
+
+void LruGarbageCollector::OnOrphanedDocumentUpdated(
+    ListenSequenceNumber previous, ListenSequenceNumber current) {
+  if (tracks_orphaned_documents()) {
+    document_sketch_.Remove(previous);
+    document_sketch_.Add(current);
+  }
+}
+
+void LruGarbageCollector::OnOrphanedDocumentGone(
+    ListenSequenceNumber sequence_number) {
+  if (tracks_orphaned_documents()) {
+    document_sketch_.Remove(sequence_number);
+  }
+}
+
+bool LruGarbageCollector::UseDocumentSketch() const {
+  return params_.approximate_sequence_numbers && document_sketch_built_ &&
+         collections_since_sketch_rebuild_ < kCollectionsPerSketchRebuild;
+}
+
 }  // namespace local
 }  // namespace firestore
 }  // namespace firebase
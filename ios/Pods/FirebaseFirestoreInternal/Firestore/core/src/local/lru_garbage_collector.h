@@ -17,7 +17,9 @@
 #ifndef FIRESTORE_CORE_SRC_LOCAL_LRU_GARBAGE_COLLECTOR_H_
 #define FIRESTORE_CORE_SRC_LOCAL_LRU_GARBAGE_COLLECTOR_H_
 
+#include <cstddef>
 #include <unordered_map>
+#include <vector>
 
 #include "Firestore/core/src/local/reference_delegate.h"
 #include "Firestore/core/src/local/target_cache.h"
@@ -45,6 +47,16 @@ struct LruParams {
   int64_t min_bytes_threshold;
   int percentile_to_collect;
   int maximum_sequence_numbers_to_collect;
+
+  /**
+   * If true, the collector estimates the sequence numbers of orphaned
+   * documents from a sketch it keeps up to date as references change,
+   * instead of enumerating every orphaned document on each collection. An
+   * exact enumeration still runs periodically to rebuild the sketch. Off by
+   * default; only delegates that report orphaned documents (see
+   * LruGarbageCollector::tracks_orphaned_documents) support it.
+   */
+  bool approximate_sequence_numbers = false;
 };
 
 struct LruResults {
@@ -60,6 +72,55 @@ struct LruResults {
 
 using LiveQueryMap = std::unordered_map<model::TargetId, TargetData>;
 
+/**
+ * A streaming quantile sketch of sequence numbers: an approximate, bounded
+ * size histogram in the spirit of a merging t-digest. Values are buffered and
+ * periodically merged into a sorted list of buckets, adjacent buckets being
+ * combined until each holds at most about 2 / max_buckets of all values, so
+ * a rank query is off by at most that fraction of the count.
+ */
+class SequenceNumberSketch {
+ public:
+  explicit SequenceNumberSketch(size_t max_buckets = 256);
+
+  void Add(model::ListenSequenceNumber sequence_number);
+
+  /**
+   * Forgets one value previously added. Values that were merged into a bucket
+   * are forgotten from whichever bucket covers them.
+   */
+  void Remove(model::ListenSequenceNumber sequence_number);
+
+  void Clear();
+
+  /** Returns the number of values in the sketch. */
+  size_t count() const {
+    return count_;
+  }
+
+  /**
+   * Returns an estimate of the nth smallest value in the sketch, or
+   * kListenSequenceNumberInvalid if the sketch is empty.
+   */
+  model::ListenSequenceNumber SequenceNumberForRank(size_t n) const;
+
+ private:
+  struct Bucket {
+    model::ListenSequenceNumber min;
+    model::ListenSequenceNumber max;
+    size_t count;
+  };
+
+  /** Merges buffered values into the buckets. */
+  void Flush() const;
+
+  size_t max_buckets_;
+  size_t count_ = 0;
+  // Sorted, non-overlapping buckets.
+  mutable std::vector<Bucket> buckets_;
+  mutable std::vector<model::ListenSequenceNumber> buffer_;
+};
+
 /**
  * Persistence layers intending to use LRU Garbage collection should implement
  * this interface. This interface defines the operations that the LRU garbage
@@ -74,6 +135,15 @@ class LruDelegate : public ReferenceDelegate {
 
   virtual util::StatusOr<int64_t> CalculateByteSize() = 0;
 
+  /**
+   * Returns a cheap estimate of CalculateByteSize(), used to decide whether
+   * garbage collection needs to run at all. Delegates that can size their
+   * cache cheaply need not override this.
+   */
+  virtual util::StatusOr<int64_t> EstimateByteSize() {
+    return CalculateByteSize();
+  }
+
   /** Returns the number of targets and orphaned documents cached. */
   virtual size_t GetSequenceNumberCount() = 0;
 
@@ -118,6 +188,8 @@ class LruGarbageCollector {
 
   util::StatusOr<int64_t> CalculateByteSize() const;
 
+  util::StatusOr<int64_t> EstimateByteSize() const;
+
   /**
    * Given a target percentile, return the number of queries that make up that
    * percentage of the queries that are cached. For instance, if 20 queries are
@@ -145,6 +217,24 @@ class LruGarbageCollector {
    */
   int RemoveOrphanedDocuments(model::ListenSequenceNumber sequence_number);
 
+  /**
+   * Whether the approximate mode's sketch of orphaned documents is live.
+   * While it is, delegates report every change to the set of orphaned
+   * documents through the methods below; otherwise they can skip the lookups
+   * needed to do so.
+   */
+  bool tracks_orphaned_documents() const;
+
+  /** A document lost its last target and is now orphaned. */
+  void OnDocumentOrphaned(model::ListenSequenceNumber sequence_number);
+
+  /** An orphaned document was given a new sequence number. */
+  void OnOrphanedDocumentUpdated(model::ListenSequenceNumber previous,
+                                 model::ListenSequenceNumber current);
+
+  /** An orphaned document was added to a target again, or removed. */
+  void OnOrphanedDocumentGone(model::ListenSequenceNumber sequence_number);
+
   local::LruResults Collect(const LiveQueryMap& live_targets);
 
   /**
@@ -155,12 +245,31 @@ class LruGarbageCollector {
   }
 
  private:
+  /**
+   * The number of collections that may use the sketch of orphaned documents
+   * before it is rebuilt by an exact enumeration.
+   */
+  static const int kCollectionsPerSketchRebuild = 10;
+
   LruResults RunGarbageCollection(const LiveQueryMap& live_targets);
 
+  /** Whether to use the sketch in place of enumerating orphaned documents. */
+  bool UseDocumentSketch() const;
+
+  /** SequenceNumberForQueryCount, estimated from the sketch. */
+  model::ListenSequenceNumber EstimateSequenceNumberForQueryCount(
+      int query_count);
+
   // Delegate owns the LruGarbageCollector; this is a back pointer.
   LruDelegate* delegate_;
 
   LruParams params_ = LruParams::Default();
+
+  // Sequence numbers of orphaned documents, or of documents that were
+  // orphaned when their sequence number was last updated.
+  SequenceNumberSketch document_sketch_;
+  bool document_sketch_built_ = false;
+  int collections_since_sketch_rebuild_ = 0;
 };
 
 }  // namespace local
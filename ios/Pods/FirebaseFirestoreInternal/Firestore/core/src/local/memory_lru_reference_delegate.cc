@@ -38,13 +38,28 @@ using model::DocumentKey;
 using model::ListenSequenceNumber;
 using util::StatusOr;
 
+namespace {
+
+/**
+ * The approximate mode relies on the delegate reporting each document that
+ * becomes orphaned; this delegate keeps every sequence number in memory and
+ * always enumerates them exactly.
+ */
+LruParams ExactSequenceNumbers(LruParams lru_params) {
+  lru_params.approximate_sequence_numbers = false;
+  return lru_params;
+}
+
+}  // namespace
+
 MemoryLruReferenceDelegate::MemoryLruReferenceDelegate(
     MemoryPersistence* persistence,
     LruParams lru_params,
     std::unique_ptr<Sizer> sizer)
     : persistence_(persistence),
       sizer_(std::move(sizer)),
-      gc_(this, lru_params) {
+      gc_(this, ExactSequenceNumbers(lru_params)) {
+  persistence_->remote_document_cache()->SetSizer(sizer_.get());
   // Theoretically this is always 0, since this is all in-memory...
   ListenSequenceNumber highest_sequence_number =
       persistence_->target_cache()->highest_listen_sequence_number();
@@ -178,10 +193,11 @@ StatusOr<int64_t> MemoryLruReferenceDelegate::CalculateByteSize() {
   // Note that this method is only used for testing because this delegate is
   // only used for testing. The algorithm here (loop through everything,
   // serialize it and count bytes) is inefficient and inexact, but won't run in
-  // production.
+  // production. Documents, which dominate the count, are sized as they are
+  // added and removed.
   int64_t count = 0;
   count += persistence_->target_cache()->CalculateByteSize(*sizer_);
-  count += persistence_->remote_document_cache()->CalculateByteSize(*sizer_);
+  count += persistence_->remote_document_cache()->CalculateByteSize();
   const auto& queues = persistence_->mutation_queues();
   for (const auto& entry : queues) {
     count += entry.second->CalculateByteSize(*sizer_);
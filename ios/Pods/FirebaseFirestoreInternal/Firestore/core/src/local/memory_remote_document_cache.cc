@@ -16,6 +16,8 @@
 
 #include "Firestore/core/src/local/memory_remote_document_cache.h"
 
+#include <utility>
+
 #include "Firestore/core/src/core/query.h"
 #include "Firestore/core/src/local/memory_lru_reference_delegate.h"
 #include "Firestore/core/src/local/memory_persistence.h"
@@ -46,14 +48,20 @@ MemoryRemoteDocumentCache::MemoryRemoteDocumentCache(
 void MemoryRemoteDocumentCache::Add(const MutableDocument& document,
                                     const model::SnapshotVersion& read_time) {
   // Note: We create an explicit copy to prevent further modifications.
-  docs_ =
-      docs_.insert(document.key(), document.Clone().WithReadTime(read_time));
+  MutableDocument copy = document.Clone();
+  copy.WithReadTime(read_time);
+  if (sizer_) {
+    SubtractByteSize(document.key());
+    byte_size_ += sizer_->CalculateByteSize(copy);
+  }
+  docs_ = docs_.insert(document.key(), std::move(copy));
 
   NOT_NULL(index_manager_);
   index_manager_->AddToCollectionParentIndex(document.key().path().PopLast());
 }
 
 void MemoryRemoteDocumentCache::Remove(const DocumentKey& key) {
+  SubtractByteSize(key);
   docs_ = docs_.erase(key);
 }
 
@@ -76,6 +84,24 @@ MutableDocumentMap MemoryRemoteDocumentCache::GetAll(
   return results;
 }
 
+MutableDocumentMap MemoryRemoteDocumentCache::GetAllProjected(
+    const DocumentKeySet& keys, const std::unordered_set<std::string>&) const {
+  // Documents are kept decoded, so there is nothing to save by projecting.
+  return GetAll(keys);
+}
+
+DocumentKeySet MemoryRemoteDocumentCache::GetFoundKeys(
+    const DocumentKeySet& keys) const {
+  DocumentKeySet found;
+  for (const DocumentKey& key : keys) {
+    const auto& entry = docs_.get(key);
+    if (entry && entry->is_found_document()) {
+      found = found.insert(key);
+    }
+  }
+  return found;
+}
+
 // This method should only be called from the IndexBackfiller if LevelDB is
 // enabled.
 MutableDocumentMap MemoryRemoteDocumentCache::GetAll(const std::string&,
@@ -144,6 +170,7 @@ std::vector<DocumentKey> MemoryRemoteDocumentCache::RemoveOrphanedDocuments(
   for (const auto& kv : docs_) {
     const DocumentKey& key = kv.first;
     if (!reference_delegate->IsPinnedAtSequenceNumber(upper_bound, key)) {
+      SubtractByteSize(key);
       updated_docs = updated_docs.erase(key);
       removed.push_back(key);
     }
@@ -152,13 +179,29 @@ std::vector<DocumentKey> MemoryRemoteDocumentCache::RemoveOrphanedDocuments(
   return removed;
 }
 
-int64_t MemoryRemoteDocumentCache::CalculateByteSize(const Sizer& sizer) {
-  int64_t count = 0;
+void MemoryRemoteDocumentCache::SetSizer(const Sizer* sizer) {
+  sizer_ = NOT_NULL(sizer);
+  byte_size_ = 0;
   for (const auto& kv : docs_) {
     const MutableDocument& document = kv.second;
-    count += sizer.CalculateByteSize(document);
+    byte_size_ += sizer_->CalculateByteSize(document);
+  }
+}
+
+int64_t MemoryRemoteDocumentCache::CalculateByteSize() const {
+  HARD_ASSERT(sizer_ != nullptr,
+              "CalculateByteSize() requires a sizer; call SetSizer() first");
+  return byte_size_;
+}
+
+void MemoryRemoteDocumentCache::SubtractByteSize(const DocumentKey& key) {
+  if (!sizer_) {
+    return;
+  }
+  const auto& entry = docs_.get(key);
+  if (entry) {
+    byte_size_ -= sizer_->CalculateByteSize(*entry);
   }
-  return count;
 }
 
 void MemoryRemoteDocumentCache::SetIndexManager(IndexManager* manager) {
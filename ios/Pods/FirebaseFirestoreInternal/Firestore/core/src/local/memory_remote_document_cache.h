@@ -18,6 +18,7 @@
 #define FIRESTORE_CORE_SRC_LOCAL_MEMORY_REMOTE_DOCUMENT_CACHE_H_
 
 #include <string>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -50,6 +51,11 @@ class MemoryRemoteDocumentCache : public RemoteDocumentCache {
   model::MutableDocument Get(const model::DocumentKey& key) const override;
   model::MutableDocumentMap GetAll(
       const model::DocumentKeySet& keys) const override;
+  model::MutableDocumentMap GetAllProjected(
+      const model::DocumentKeySet& keys,
+      const std::unordered_set<std::string>& field_names) const override;
+  model::DocumentKeySet GetFoundKeys(
+      const model::DocumentKeySet& keys) const override;
   model::MutableDocumentMap GetAll(const std::string&,
                                    const model::IndexOffset&,
                                    size_t) const override;
@@ -71,9 +77,24 @@ class MemoryRemoteDocumentCache : public RemoteDocumentCache {
       MemoryLruReferenceDelegate* reference_delegate,
       model::ListenSequenceNumber upper_bound);
 
-  int64_t CalculateByteSize(const Sizer& sizer);
+  /**
+   * Starts keeping a running total of the size of the cached documents as
+   * measured by `sizer`, so that CalculateByteSize() need not size every
+   * document.
+   */
+  void SetSizer(const Sizer* sizer);
+
+  /**
+   * Returns the total size of the cached documents.
+   *
+   * Requires that a sizer has been set with SetSizer().
+   */
+  int64_t CalculateByteSize() const;
 
  private:
+  /** Adjusts the running total for the removal of the given document. */
+  void SubtractByteSize(const model::DocumentKey& key);
+
   /** Underlying cache of documents and their read times. */
   immutable::SortedMap<model::DocumentKey, model::MutableDocument> docs_;
 
@@ -81,6 +102,10 @@ class MemoryRemoteDocumentCache : public RemoteDocumentCache {
   MemoryPersistence* persistence_;
   // This instance is also owned by MemoryPersistence.
   IndexManager* index_manager_ = nullptr;
+  // Owned by the MemoryLruReferenceDelegate, if any.
+  const Sizer* sizer_ = nullptr;
+  // The total size of `docs_` as measured by `sizer_`.
+  int64_t byte_size_ = 0;
 };
 
 }  // namespace local
@@ -16,6 +16,10 @@
 
 #include "Firestore/core/src/local/query_engine.h"
 
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <unordered_set>
 #include <utility>
 
 #include "Firestore/core/src/core/query.h"
@@ -25,7 +29,10 @@
 #include "Firestore/core/src/model/document.h"
 #include "Firestore/core/src/model/document_set.h"
 #include "Firestore/core/src/model/mutable_document.h"
+#include "Firestore/core/src/model/object_value.h"
 #include "Firestore/core/src/model/snapshot_version.h"
+#include "Firestore/core/src/model/value_util.h"
+#include "Firestore/core/src/nanopb/message.h"
 #include "Firestore/core/src/util/log.h"
 
 namespace firebase {
@@ -44,17 +51,156 @@ static const int kDefaultIndexAutoCreationMinCollectionSize = 100;
  */
 
 static const double KDefaultRelativeIndexReadCostPerDocument = 3.4;
+
+using model::IsDouble;
+using model::IsInteger;
+using nanopb::Message;
+
+/**
+ * Adds up the numeric values of a field like the backend does for SUM: the
+ * sum stays an integer until a double is added or the integer sum overflows.
+ * Values that aren't numbers are ignored.
+ */
+class NumericSum {
+ public:
+  void Add(const absl::optional<google_firestore_v1_Value>& value) {
+    if (IsInteger(value)) {
+      int64_t operand = value->integer_value;
+      if (!is_double_ && !AdditionOverflows(integer_sum_, operand)) {
+        integer_sum_ += operand;
+      } else {
+        SwitchToDouble();
+        double_sum_ += static_cast<double>(operand);
+      }
+      ++count_;
+    } else if (IsDouble(value)) {
+      SwitchToDouble();
+      double_sum_ += value->double_value;
+      ++count_;
+    }
+  }
+
+  Message<google_firestore_v1_Value> Sum() const {
+    Message<google_firestore_v1_Value> result;
+    if (is_double_) {
+      result->which_value_type = google_firestore_v1_Value_double_value_tag;
+      result->double_value = double_sum_;
+    } else {
+      result->which_value_type = google_firestore_v1_Value_integer_value_tag;
+      result->integer_value = integer_sum_;
+    }
+    return result;
+  }
+
+  /** The mean of the added values, or null if none were numbers. */
+  Message<google_firestore_v1_Value> Average() const {
+    if (count_ == 0) {
+      return Message<google_firestore_v1_Value>{model::NullValue()};
+    }
+    double sum = is_double_ ? double_sum_ : static_cast<double>(integer_sum_);
+    Message<google_firestore_v1_Value> result;
+    result->which_value_type = google_firestore_v1_Value_double_value_tag;
+    result->double_value = sum / static_cast<double>(count_);
+    return result;
+  }
+
+ private:
+  static bool AdditionOverflows(int64_t lhs, int64_t rhs) {
+    return rhs > 0 ? lhs > std::numeric_limits<int64_t>::max() - rhs
+                   : lhs < std::numeric_limits<int64_t>::min() - rhs;
+  }
+
+  void SwitchToDouble() {
+    if (!is_double_) {
+      double_sum_ = static_cast<double>(integer_sum_);
+      is_double_ = true;
+    }
+  }
+
+  int64_t integer_sum_ = 0;
+  double double_sum_ = 0;
+  bool is_double_ = false;
+  size_t count_ = 0;
+};
+
 }  // namespace
 
 using core::LimitType;
 using core::Query;
+using model::AggregateField;
 using model::Document;
+using model::DocumentKey;
 using model::DocumentKeySet;
 using model::DocumentMap;
 using model::DocumentSet;
+using model::FieldPath;
 using model::MutableDocument;
+using model::ObjectValue;
 using model::SnapshotVersion;
 
+/** Computes a set of aggregates over the documents that it's fed. */
+class QueryEngine::AggregateAccumulator {
+ public:
+  explicit AggregateAccumulator(const std::vector<AggregateField>& aggregates)
+      : aggregates_(aggregates), sums_(aggregates.size()) {
+  }
+
+  /**
+   * The top-level fields that documents fed to `AddDocument` need to contain,
+   * or an empty set if only documents are counted.
+   */
+  std::unordered_set<std::string> field_names() const {
+    std::unordered_set<std::string> result;
+    for (const AggregateField& aggregate : aggregates_) {
+      if (aggregate.op != AggregateField::OpKind::Count) {
+        result.insert(aggregate.fieldPath.first_segment());
+      }
+    }
+    return result;
+  }
+
+  void AddDocument(const MutableDocument& document) {
+    ++count_;
+    for (size_t i = 0; i != aggregates_.size(); ++i) {
+      if (aggregates_[i].op != AggregateField::OpKind::Count) {
+        sums_[i].Add(document.field(aggregates_[i].fieldPath));
+      }
+    }
+  }
+
+  /** Counts documents that match without feeding them. */
+  void AddCount(size_t count) {
+    count_ += static_cast<int64_t>(count);
+  }
+
+  ObjectValue Result() const {
+    ObjectValue result;
+    for (size_t i = 0; i != aggregates_.size(); ++i) {
+      const AggregateField& aggregate = aggregates_[i];
+      Message<google_firestore_v1_Value> value;
+      switch (aggregate.op) {
+        case AggregateField::OpKind::Count:
+          value->which_value_type = google_firestore_v1_Value_integer_value_tag;
+          value->integer_value = count_;
+          break;
+        case AggregateField::OpKind::Sum:
+          value = sums_[i].Sum();
+          break;
+        case AggregateField::OpKind::Avg:
+          value = sums_[i].Average();
+          break;
+      }
+      result.Set(FieldPath{aggregate.alias.StringValue()}, std::move(value));
+    }
+    return result;
+  }
+
+ private:
+  const std::vector<AggregateField>& aggregates_;
+  std::vector<NumericSum> sums_;
+  int64_t count_ = 0;
+};
+
 void QueryEngine::Initialize(LocalDocumentsView* local_documents) {
   local_documents_view_ = local_documents;
   index_manager_ = local_documents->index_manager();
@@ -91,6 +237,113 @@ const DocumentMap QueryEngine::GetDocumentsMatchingQuery(
   return full_scan_result;
 }
 
+ObjectValue QueryEngine::GetAggregates(
+    const Query& query,
+    const std::vector<AggregateField>& aggregates,
+    const SnapshotVersion& last_limbo_free_snapshot_version,
+    const DocumentKeySet& remote_keys) const {
+  HARD_ASSERT(local_documents_view_ && index_manager_,
+              "Initialize() not called");
+
+  AggregateAccumulator accumulator(aggregates);
+  if (AggregateUsingIndex(query, &accumulator)) {
+    return accumulator.Result();
+  }
+
+  DocumentSet results = ApplyQuery(
+      query, GetDocumentsMatchingQuery(query, last_limbo_free_snapshot_version,
+                                       remote_keys));
+
+  // The backend applies the limit before aggregating.
+  size_t skip = 0;
+  size_t take = results.size();
+  if (query.has_limit() &&
+      results.size() > static_cast<size_t>(query.limit())) {
+    take = static_cast<size_t>(query.limit());
+    if (query.limit_type() == LimitType::Last) {
+      skip = results.size() - take;
+    }
+  }
+  size_t position = 0;
+  for (const Document& document : results) {
+    if (position++ < skip) {
+      continue;
+    }
+    if (take-- == 0) {
+      break;
+    }
+    accumulator.AddDocument(document.get());
+  }
+  return accumulator.Result();
+}
+
+bool QueryEngine::AggregateUsingIndex(const Query& query,
+                                      AggregateAccumulator* accumulator) const {
+  // Limits are applied in the query's order, which would require reading the
+  // documents. Collection groups span several collections' overlays.
+  if (query.MatchesAllDocuments() || query.has_limit() ||
+      query.IsCollectionGroupQuery() || query.IsDocumentQuery()) {
+    return false;
+  }
+
+  const core::Target& target = query.ToTarget();
+  if (index_manager_->GetIndexType(target) != IndexManager::IndexType::FULL) {
+    return false;
+  }
+  absl::optional<std::vector<DocumentKey>> indexed_keys =
+      index_manager_->GetDocumentsMatchingTarget(target);
+  if (!indexed_keys) {
+    return false;
+  }
+
+  // The index entries of documents with local mutations, or that changed after
+  // they were indexed, may be stale. Evaluate those documents in full.
+  model::IndexOffset offset = index_manager_->GetMinOffset(target);
+  DocumentKeySet changed_keys;
+  for (const auto& entry :
+       local_documents_view_->document_overlay_cache()->GetOverlays(
+           query.path(), model::IndexOffset::InitialLargestBatchId())) {
+    changed_keys = changed_keys.insert(entry.first);
+  }
+  RemoteDocumentCache* remote_documents =
+      local_documents_view_->remote_document_cache();
+  for (const auto& entry : remote_documents->GetDocumentsMatchingQuery(
+           Query(query.path()), offset)) {
+    changed_keys = changed_keys.insert(entry.first);
+  }
+  for (const auto& entry : local_documents_view_->GetDocuments(changed_keys)) {
+    const Document& document = entry.second;
+    if (document->is_found_document() && query.Matches(document)) {
+      accumulator->AddDocument(document.get());
+    }
+  }
+
+  // Every other indexed document matches as it is stored.
+  DocumentKeySet unchanged_keys;
+  for (const DocumentKey& key : *indexed_keys) {
+    if (!changed_keys.contains(key)) {
+      unchanged_keys = unchanged_keys.insert(key);
+    }
+  }
+
+  std::unordered_set<std::string> field_names = accumulator->field_names();
+  if (field_names.empty()) {
+    // LRU garbage collection removes documents but not their index entries,
+    // so only count keys that still have a document.
+    accumulator->AddCount(
+        remote_documents->GetFoundKeys(unchanged_keys).size());
+    return true;
+  }
+
+  for (const auto& entry :
+       remote_documents->GetAllProjected(unchanged_keys, field_names)) {
+    if (entry.second.is_found_document()) {
+      accumulator->AddDocument(entry.second);
+    }
+  }
+  return true;
+}
+
 void QueryEngine::CreateCacheIndexes(const core::Query& query,
                                      const QueryContext& context,
                                      size_t result_size) const {
@@ -17,6 +17,9 @@
 #ifndef FIRESTORE_CORE_SRC_LOCAL_QUERY_ENGINE_H_
 #define FIRESTORE_CORE_SRC_LOCAL_QUERY_ENGINE_H_
 
+#include <vector>
+
+#include "Firestore/core/src/model/aggregate_field.h"
 #include "Firestore/core/src/model/model_fwd.h"
 
 namespace firebase {
@@ -79,12 +82,37 @@ class QueryEngine {
       const model::SnapshotVersion& last_limbo_free_snapshot_version,
       const model::DocumentKeySet& remote_keys) const;
 
+  /**
+   * Computes `aggregates` over the documents in the cache that match `query`,
+   * keyed by alias like the result of a RunAggregationQuery request.
+   *
+   * When the query is served by a full index, COUNT is answered from the
+   * index entries and the documents with local mutations, without decoding the
+   * documents that are known to match. SUM and AVG decode only the fields
+   * they aggregate. Otherwise the matching documents are read in full.
+   */
+  model::ObjectValue GetAggregates(
+      const core::Query& query,
+      const std::vector<model::AggregateField>& aggregates,
+      const model::SnapshotVersion& last_limbo_free_snapshot_version,
+      const model::DocumentKeySet& remote_keys) const;
+
   void SetIndexAutoCreationEnabled(bool is_enabled);
 
  private:
   friend class IndexManagerTest;
   friend class LocalStoreTestBase;
 
+  class AggregateAccumulator;
+
+  /**
+   * Feeds the documents matching `query` to `accumulator` using the query's
+   * full index. Returns false, having fed nothing, if there is no full index
+   * for the query.
+   */
+  bool AggregateUsingIndex(const core::Query& query,
+                           AggregateAccumulator* accumulator) const;
+
   /**
    * Performs an indexed query that evaluates the query based on a collection's
    * persisted index values. Returns nullopt if an index is not available.
@@ -18,6 +18,7 @@
 #define FIRESTORE_CORE_SRC_LOCAL_REMOTE_DOCUMENT_CACHE_H_
 
 #include <string>
+#include <unordered_set>
 
 #include "Firestore/core/src/model/document_key.h"
 #include "Firestore/core/src/model/model_fwd.h"
@@ -81,6 +82,25 @@ class RemoteDocumentCache {
   virtual model::MutableDocumentMap GetAll(
       const model::DocumentKeySet& keys) const = 0;
 
+  /**
+   * Looks up a set of entries in the cache like `GetAll`, but only needs the
+   * returned documents to contain the top-level fields in `field_names`.
+   * Implementations that store encoded documents can skip decoding the rest.
+   *
+   * @param keys The keys of the entries to look up.
+   * @param field_names The names of the top-level fields to read.
+   */
+  virtual model::MutableDocumentMap GetAllProjected(
+      const model::DocumentKeySet& keys,
+      const std::unordered_set<std::string>& field_names) const = 0;
+
+  /**
+   * Returns the subset of `keys` whose cache entry is a found document,
+   * without decoding the documents' fields.
+   */
+  virtual model::DocumentKeySet GetFoundKeys(
+      const model::DocumentKeySet& keys) const = 0;
+
   /**
    * Looks up the next "limit" number of documents for a collection group based
    * on the provided offset. The ordering is based on the document's read time
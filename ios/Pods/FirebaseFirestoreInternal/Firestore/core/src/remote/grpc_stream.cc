@@ -135,6 +135,18 @@ void GrpcStream::Read() {
   call_->Read(completion->message(), completion.get());
 }
 
+void GrpcStream::PauseReads() {
+  reads_paused_ = true;
+}
+
+void GrpcStream::ResumeReads() {
+  reads_paused_ = false;
+  if (read_deferred_) {
+    read_deferred_ = false;
+    Read();
+  }
+}
+
 void GrpcStream::Write(grpc::ByteBuffer&& message) {
   MaybeWrite(buffered_writer_.EnqueueWrite(std::move(message)));
 }
@@ -294,10 +306,14 @@ GrpcStream::Metadata GrpcStream::GetResponseHeaders() const {
 void GrpcStream::OnRead(const grpc::ByteBuffer& message) {
   if (observer_) {
     // Continue waiting for new messages indefinitely as long as there is an
-    // interested observer.
+    // interested observer, unless it asked for reads to be paused.
     // Order is important here -- any call to observer can potentially end this
     // stream's lifetime, so call `Read` before notifying.
-    Read();
+    if (reads_paused_) {
+      read_deferred_ = true;
+    } else {
+      Read();
+    }
     observer_->OnStreamRead(message);
   }
 }
@@ -169,6 +169,14 @@ class GrpcStream : public GrpcCall {
     return observer_ == nullptr;
   }
 
+  /**
+   * Stops requesting new messages from gRPC until `ResumeReads` is called, so
+   * that the server is held back by flow control. A read that is already
+   * pending still completes, so one more message may arrive after this call.
+   */
+  void PauseReads();
+  void ResumeReads();
+
   /**
    * Returns the metadata received from the server.
    *
@@ -239,6 +247,11 @@ class GrpcStream : public GrpcCall {
 
   // gRPC asserts that a call is finished exactly once.
   bool is_grpc_call_finished_ = false;
+
+  bool reads_paused_ = false;
+  // Whether a read was skipped because reads were paused, and so has to be
+  // issued on resume.
+  bool read_deferred_ = false;
 };
 
 }  // namespace remote
@@ -16,6 +16,8 @@
 
 #include "Firestore/core/src/remote/remote_objc_bridge.h"
 
+#include <pb_encode.h>
+
 #include <map>
 
 #include "Firestore/core/src/core/database_info.h"
@@ -25,6 +27,7 @@
 #include "Firestore/core/src/model/document.h"
 #include "Firestore/core/src/model/document_key.h"
 #include "Firestore/core/src/model/mutation.h"
+#include "Firestore/core/src/model/mutation_batch.h"
 #include "Firestore/core/src/model/snapshot_version.h"
 #include "Firestore/core/src/nanopb/byte_string.h"
 #include "Firestore/core/src/nanopb/nanopb_util.h"
@@ -50,6 +53,7 @@ using model::AggregateField;
 using model::Document;
 using model::DocumentKey;
 using model::Mutation;
+using model::MutationBatch;
 using model::MutationResult;
 using model::ObjectValue;
 using model::SnapshotVersion;
@@ -166,6 +170,58 @@ WriteStreamSerializer::EncodeEmptyMutationsList(
   return EncodeWriteMutationsRequest({}, last_stream_token);
 }
 
+Message<google_firestore_v1_WriteRequest>
+WriteStreamSerializer::EncodeWriteMutationBatchesRequest(
+    absl::Span<const MutationBatch> batches,
+    size_t max_bytes,
+    size_t max_writes,
+    const ByteString& last_stream_token,
+    size_t* batch_count) const {
+  std::vector<google_firestore_v1_Write> writes;
+  size_t total_bytes = 0;
+  size_t count = 0;
+  for (const MutationBatch& batch : batches) {
+    const std::vector<Mutation>& mutations = batch.mutations();
+    if (count > 0 && writes.size() + mutations.size() > max_writes) {
+      break;
+    }
+
+    size_t batch_bytes = 0;
+    size_t first_write = writes.size();
+    for (const Mutation& mutation : mutations) {
+      writes.push_back(serializer_.EncodeMutation(mutation));
+      size_t write_bytes = 0;
+      pb_get_encoded_size(&write_bytes, google_firestore_v1_Write_fields,
+                          &writes.back());
+      batch_bytes += write_bytes;
+    }
+
+    if (count > 0 && total_bytes + batch_bytes > max_bytes) {
+      for (size_t i = first_write; i != writes.size(); ++i) {
+        nanopb::FreeNanopbMessage(google_firestore_v1_Write_fields,
+                                  &writes[i]);
+      }
+      writes.resize(first_write);
+      break;
+    }
+    total_bytes += batch_bytes;
+    ++count;
+  }
+
+  Message<google_firestore_v1_WriteRequest> result;
+  if (!writes.empty()) {
+    result->writes_count = nanopb::CheckedSize(writes.size());
+    result->writes = MakeArray<google_firestore_v1_Write>(result->writes_count);
+    for (pb_size_t i = 0; i != result->writes_count; ++i) {
+      result->writes[i] = writes[i];
+    }
+  }
+  result->stream_token = nanopb::CopyBytesArray(last_stream_token.get());
+
+  *batch_count = count;
+  return result;
+}
+
 Message<google_firestore_v1_WriteResponse> WriteStreamSerializer::ParseResponse(
     Reader* reader) const {
   return Message<google_firestore_v1_WriteResponse>::TryParse(reader);
@@ -33,6 +33,7 @@
 #include "grpcpp/support/byte_buffer.h"
 
 #include "absl/container/flat_hash_map.h"
+#include "absl/types/span.h"
 
 namespace firebase {
 namespace firestore {
@@ -44,6 +45,7 @@ class TargetData;
 namespace model {
 class AggregateField;
 class DocumentKey;
+class MutationBatch;
 class SnapshotVersion;
 }  // namespace model
 
@@ -103,6 +105,20 @@ class WriteStreamSerializer {
   nanopb::Message<google_firestore_v1_WriteRequest> EncodeEmptyMutationsList(
       const nanopb::ByteString& last_stream_token) const;
 
+  /**
+   * Encodes a write request holding the mutations of as many leading
+   * `batches` as fit within `max_bytes` of encoded writes and `max_writes`
+   * writes, but always at least the first batch. Each batch is encoded only
+   * once. Sets `*batch_count` to the number of batches included.
+   */
+  nanopb::Message<google_firestore_v1_WriteRequest>
+  EncodeWriteMutationBatchesRequest(
+      absl::Span<const model::MutationBatch> batches,
+      size_t max_bytes,
+      size_t max_writes,
+      const nanopb::ByteString& last_stream_token,
+      size_t* batch_count) const;
+
   nanopb::Message<google_firestore_v1_WriteResponse> ParseResponse(
       nanopb::Reader* reader) const;
   model::SnapshotVersion DecodeCommitVersion(
@@ -16,6 +16,8 @@
 
 #include "Firestore/core/src/remote/remote_store.h"
 
+#include <algorithm>
+#include <iterator>
 #include <string>
 #include <utility>
 
@@ -41,6 +43,7 @@ using local::QueryPurpose;
 using local::TargetData;
 using model::AggregateField;
 using model::BatchId;
+using model::DocumentKey;
 using model::DocumentKeySet;
 using model::kBatchIdUnknown;
 using model::MutationBatch;
@@ -54,10 +57,14 @@ using util::AsyncQueue;
 using util::Status;
 
 /**
- * The maximum number of pending writes to allow.
+ * The number of pending writes to allow initially, and the least that the
+ * adaptive pipeline depth will shrink to.
  * TODO(b/35853402): Negotiate this value with the backend.
  */
-constexpr int kMaxPendingWrites = 10;
+constexpr size_t kMinPendingWrites = 10;
+
+/** The most pending writes that the adaptive pipeline depth will grow to. */
+constexpr size_t kMaxPendingWrites = 100;
 
 RemoteStore::RemoteStore(
     LocalStore* local_store,
@@ -68,7 +75,8 @@ RemoteStore::RemoteStore(
     : local_store_{local_store},
       datastore_{std::move(datastore)},
       online_state_tracker_{worker_queue, std::move(online_state_handler)},
-      connectivity_monitor_{NOT_NULL(connectivity_monitor)} {
+      connectivity_monitor_{NOT_NULL(connectivity_monitor)},
+      max_pending_writes_{kMinPendingWrites} {
   datastore_->Start();
 
   // Create streams (but note they're not started yet)
@@ -134,6 +142,7 @@ void RemoteStore::DisableNetworkInternal() {
               write_pipeline_.size());
     write_pipeline_.clear();
   }
+  ResetSentWrites();
 
   CleanUpWatchStreamState();
 }
@@ -405,9 +414,12 @@ void RemoteStore::FillWritePipeline() {
       }
       break;
     }
-    AddToWritePipeline(*batch);
     last_batch_id_retrieved = batch->batch_id();
+    write_pipeline_.push_back(*std::move(batch));
   }
+  // Send everything fetched above together, so consecutive batches can share
+  // write requests.
+  SendPendingWrites();
 
   if (ShouldStartWriteStream()) {
     StartWriteStream();
@@ -415,7 +427,7 @@ void RemoteStore::FillWritePipeline() {
 }
 
 bool RemoteStore::CanAddToWritePipeline() const {
-  return CanUseNetwork() && write_pipeline_.size() < kMaxPendingWrites;
+  return CanUseNetwork() && write_pipeline_.size() < max_pending_writes_;
 }
 
 void RemoteStore::AddToWritePipeline(const MutationBatch& batch) {
@@ -423,9 +435,71 @@ void RemoteStore::AddToWritePipeline(const MutationBatch& batch) {
               "AddToWritePipeline called when pipeline is full");
 
   write_pipeline_.push_back(batch);
+  SendPendingWrites();
+}
+
+void RemoteStore::SendPendingWrites() {
+  if (!write_stream_->IsOpen() || !write_stream_->handshake_complete()) {
+    return;
+  }
+
+  while (sent_write_count_ < write_pipeline_.size()) {
+    absl::Span<const MutationBatch> unsent =
+        absl::MakeConstSpan(write_pipeline_).subspan(sent_write_count_);
+    unsent = unsent.subspan(0, CoalescableBatchCount(unsent));
+
+    size_t batch_count = write_stream_->WriteMutationBatches(unsent);
+    sent_write_count_ += batch_count;
+    sent_write_requests_.push_back(
+        SentWriteRequest{batch_count, std::chrono::steady_clock::now()});
+  }
+}
+
+size_t RemoteStore::CoalescableBatchCount(
+    absl::Span<const MutationBatch> batches) const {
+  if (!coalesce_writes_ ||
+      batches.front().batch_id() <= last_uncoalesced_batch_id_) {
+    return 1;
+  }
+
+  DocumentKeySet keys;
+  size_t count = 0;
+  for (const MutationBatch& batch : batches) {
+    DocumentKeySet batch_keys = batch.keys();
+    for (const DocumentKey& key : batch_keys) {
+      if (keys.contains(key)) {
+        return std::max<size_t>(count, 1);
+      }
+    }
+    keys = keys.union_with(batch_keys);
+    ++count;
+  }
+  return count;
+}
 
-  if (write_stream_->IsOpen() && write_stream_->handshake_complete()) {
-    write_stream_->WriteMutations(batch.mutations());
+void RemoteStore::ResetSentWrites() {
+  sent_write_requests_.clear();
+  sent_write_count_ = 0;
+}
+
+void RemoteStore::UpdateWritePipelineDepth(
+    std::chrono::steady_clock::duration rtt, bool pipeline_full) {
+  min_write_rtt_ = std::min(min_write_rtt_, rtt);
+  if (smoothed_write_rtt_ == std::chrono::steady_clock::duration::zero()) {
+    smoothed_write_rtt_ = rtt;
+  } else {
+    smoothed_write_rtt_ = (smoothed_write_rtt_ * 7 + rtt) / 8;
+  }
+
+  if (smoothed_write_rtt_ > min_write_rtt_ * 2) {
+    // Round trips have slowed well beyond the best observed: more writes in
+    // flight would only queue up behind each other.
+    if (max_pending_writes_ > kMinPendingWrites) {
+      --max_pending_writes_;
+    }
+  } else if (pipeline_full && max_pending_writes_ < kMaxPendingWrites) {
+    // Writes are limited by the pipeline depth rather than by the backend.
+    ++max_pending_writes_;
   }
 }
 
@@ -449,25 +523,52 @@ void RemoteStore::OnWriteStreamHandshakeComplete() {
   local_store_->SetLastStreamToken(write_stream_->last_stream_token());
 
   // Send the write pipeline now that the stream is established.
-  for (const MutationBatch& write : write_pipeline_) {
-    write_stream_->WriteMutations(write.mutations());
-  }
+  ResetSentWrites();
+  SendPendingWrites();
 }
 
 void RemoteStore::OnWriteStreamMutationResult(
     SnapshotVersion commit_version,
     std::vector<MutationResult> mutation_results) {
-  // This is a response to a write containing mutations and should be correlated
-  // to the first write in our write pipeline.
-  HARD_ASSERT(!write_pipeline_.empty(), "Got result for empty write pipeline");
-
-  MutationBatch batch = write_pipeline_.front();
-  write_pipeline_.erase(write_pipeline_.begin());
+  // This is a response to the oldest unacknowledged write request, which
+  // holds one or more writes from the front of our write pipeline.
+  HARD_ASSERT(!sent_write_requests_.empty(),
+              "Got result for empty write pipeline");
+
+  SentWriteRequest request = sent_write_requests_.front();
+  sent_write_requests_.pop_front();
+  HARD_ASSERT(request.batch_count <= write_pipeline_.size(),
+              "Got result for %s writes with only %s in the write pipeline",
+              request.batch_count, write_pipeline_.size());
+
+  if (adaptive_write_pipeline_) {
+    UpdateWritePipelineDepth(
+        std::chrono::steady_clock::now() - request.sent_at,
+        write_pipeline_.size() >= max_pending_writes_);
+  }
 
-  MutationBatchResult batch_result(std::move(batch), commit_version,
-                                   std::move(mutation_results),
-                                   write_stream_->last_stream_token());
-  sync_engine_->HandleSuccessfulWrite(std::move(batch_result));
+  // The results of all writes in the request arrive together, in order.
+  auto results = std::make_move_iterator(mutation_results.begin());
+  auto results_end = std::make_move_iterator(mutation_results.end());
+  for (size_t i = 0; i != request.batch_count; ++i) {
+    MutationBatch batch = write_pipeline_.front();
+    write_pipeline_.erase(write_pipeline_.begin());
+    --sent_write_count_;
+
+    auto batch_results_end =
+        request.batch_count == 1
+            ? results_end
+            : std::next(results, static_cast<std::ptrdiff_t>(std::min<size_t>(
+                                     batch.mutations().size(),
+                                     std::distance(results, results_end))));
+    std::vector<MutationResult> batch_results(results, batch_results_end);
+    results = batch_results_end;
+
+    MutationBatchResult batch_result(std::move(batch), commit_version,
+                                     std::move(batch_results),
+                                     write_stream_->last_stream_token());
+    sync_engine_->HandleSuccessfulWrite(std::move(batch_result));
+  }
 
   // It's possible that with the completion of this mutation another slot has
   // freed up.
@@ -498,6 +599,9 @@ void RemoteStore::OnWriteStreamClose(const Status& status) {
     }
   }
 
+  // Anything unacknowledged is sent again on the next stream.
+  ResetSentWrites();
+
   // The write stream might have been started by refilling the write pipeline
   // for failed writes
   if (ShouldStartWriteStream()) {
@@ -535,6 +639,17 @@ void RemoteStore::HandleWriteError(const Status& status) {
     return;
   }
 
+  // A rejected request that held several writes doesn't say which of them was
+  // the problem. Resend them one per request to find out.
+  if (!sent_write_requests_.empty() &&
+      sent_write_requests_.front().batch_count > 1) {
+    last_uncoalesced_batch_id_ =
+        write_pipeline_[sent_write_requests_.front().batch_count - 1]
+            .batch_id();
+    write_stream_->InhibitBackoff();
+    return;
+  }
+
   // If this was a permanent error, the request itself was the problem so it's
   // not going to succeed if we resend it.
   MutationBatch batch = write_pipeline_.front();
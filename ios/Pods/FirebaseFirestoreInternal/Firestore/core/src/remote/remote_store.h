@@ -17,6 +17,8 @@
 #ifndef FIRESTORE_CORE_SRC_REMOTE_REMOTE_STORE_H_
 #define FIRESTORE_CORE_SRC_REMOTE_REMOTE_STORE_H_
 
+#include <chrono>
+#include <deque>
 #include <memory>
 #include <unordered_map>
 #include <vector>
@@ -34,6 +36,7 @@
 #include "Firestore/core/src/remote/write_stream.h"
 #include "Firestore/core/src/util/async_queue.h"
 #include "Firestore/core/src/util/status_fwd.h"
+#include "absl/types/span.h"
 
 namespace firebase {
 namespace firestore {
@@ -122,6 +125,30 @@ class RemoteStore : public TargetMetadataProvider,
     sync_engine_ = sync_engine;
   }
 
+  /**
+   * Whether consecutive mutation batches may be sent in a shared write
+   * request. Off by default.
+   *
+   * The backend commits each write request atomically, so a batch sent this
+   * way is committed only if every batch it shares the request with is too,
+   * and all of them get the same commit version. A rejected request is
+   * resent one batch per request, so each batch still ends up with its own
+   * outcome, but the resends cost extra round trips. Only batches that touch
+   * distinct documents are combined, so that no write's precondition depends
+   * on another write in the same request.
+   */
+  void set_coalesce_writes(bool value) {
+    coalesce_writes_ = value;
+  }
+
+  /**
+   * Whether the number of pending writes adapts to acknowledgement round-trip
+   * times, between 10 and 100. Off by default, which keeps it at 10.
+   */
+  void set_adaptive_write_pipeline(bool value) {
+    adaptive_write_pipeline_ = value;
+  }
+
   /**
    * Starts up the remote store, creating streams, restoring state from
    * `LocalStore`, etc.
@@ -238,6 +265,35 @@ class RemoteStore : public TargetMetadataProvider,
    */
   bool CanAddToWritePipeline() const;
 
+  /**
+   * Sends every write in `write_pipeline_` that hasn't been sent on the
+   * current write stream yet, coalescing consecutive batches into shared
+   * write requests if `coalesce_writes_` is set. Does nothing until the write
+   * stream handshake completes.
+   */
+  void SendPendingWrites();
+
+  /**
+   * Returns how many leading `batches` may share a write request: at least
+   * one, and only as many as touch distinct documents.
+   */
+  size_t CoalescableBatchCount(
+      absl::Span<const model::MutationBatch> batches) const;
+
+  /**
+   * Forgets which writes have been sent, so that they are all sent again once
+   * the write stream is re-established.
+   */
+  void ResetSentWrites();
+
+  /**
+   * Adjusts `max_pending_writes_` given the round-trip time of an
+   * acknowledged write request and whether the pipeline was full when it was
+   * acknowledged.
+   */
+  void UpdateWritePipelineDepth(std::chrono::steady_clock::duration rtt,
+                                bool pipeline_full);
+
   void StartWriteStream();
 
   /**
@@ -296,7 +352,7 @@ class RemoteStore : public TargetMetadataProvider,
   std::unique_ptr<WatchChangeAggregator> watch_change_aggregator_;
 
   /**
-   * A list of up to `kMaxPendingWrites` writes that we have fetched from the
+   * A list of up to `max_pending_writes_` writes that we have fetched from the
    * `LocalStore` via `FillWritePipeline` and have or will send to the write
    * stream.
    *
@@ -310,9 +366,47 @@ class RemoteStore : public TargetMetadataProvider,
    *
    * Write responses from the backend are linked to their originating request
    * purely based on order, and so we can just remove writes from the front of
-   * the `write_pipeline_` as we receive responses.
+   * the `write_pipeline_` as we receive responses. A request may hold several
+   * consecutive writes; `sent_write_requests_` records how many.
    */
   std::vector<model::MutationBatch> write_pipeline_;
+
+  /** A write request sent on the current write stream and not yet acked. */
+  struct SentWriteRequest {
+    size_t batch_count = 0;
+    std::chrono::steady_clock::time_point sent_at;
+  };
+
+  /** The unacknowledged write requests, in the order they were sent. */
+  std::deque<SentWriteRequest> sent_write_requests_;
+
+  /**
+   * The number of writes at the front of `write_pipeline_` that have been sent
+   * on the current write stream.
+   */
+  size_t sent_write_count_ = 0;
+
+  /**
+   * Writes with batch IDs up to this one are sent in requests of their own.
+   * Set when the backend rejects a coalesced request, so that the rejection
+   * can be attributed to the batch that caused it.
+   */
+  model::BatchId last_uncoalesced_batch_id_ = model::kBatchIdUnknown;
+
+  bool coalesce_writes_ = false;
+  bool adaptive_write_pipeline_ = false;
+
+  /**
+   * The current limit on the size of `write_pipeline_`. If
+   * `adaptive_write_pipeline_` is set, grows while the pipeline is full and
+   * acknowledgements arrive promptly, and shrinks when round trips slow down.
+   */
+  size_t max_pending_writes_;
+
+  std::chrono::steady_clock::duration min_write_rtt_ =
+      std::chrono::steady_clock::duration::max();
+  std::chrono::steady_clock::duration smoothed_write_rtt_ =
+      std::chrono::steady_clock::duration::zero();
 };
 
 }  // namespace remote
@@ -260,10 +260,7 @@ void Stream::OnStreamRead(const grpc::ByteBuffer& message) {
 
   Status read_status = NotifyStreamResponse(message);
   if (!read_status.ok()) {
-    grpc_stream_->FinishImmediately();
-    // Don't expect gRPC to produce status -- since the error happened on the
-    // client, we have all the information we need.
-    OnStreamFinish(read_status);
+    CloseWithClientError(read_status);
     return;
   }
 }
@@ -383,6 +380,28 @@ std::string Stream::GetDebugDescription() const {
   return StringFormat("%s (%x)", GetDebugName(), this);
 }
 
+void Stream::SetReadsPaused(bool paused) {
+  EnsureOnQueue();
+
+  if (!grpc_stream_) {
+    return;
+  }
+  if (paused) {
+    grpc_stream_->PauseReads();
+  } else {
+    grpc_stream_->ResumeReads();
+  }
+}
+
+void Stream::CloseWithClientError(const Status& status) {
+  EnsureOnQueue();
+
+  grpc_stream_->FinishImmediately();
+  // Don't expect gRPC to produce status -- since the error happened on the
+  // client, we have all the information we need.
+  OnStreamFinish(status);
+}
+
 }  // namespace remote
 }  // namespace firestore
 }  // namespace firebase
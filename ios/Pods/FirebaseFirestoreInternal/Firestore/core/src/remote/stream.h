@@ -209,6 +209,32 @@ class Stream : public GrpcStreamObserver,
   void Write(grpc::ByteBuffer&& message);
   std::string GetDebugDescription() const;
 
+  /**
+   * Closes the stream because of an error detected on the client (for example,
+   * a response that fails to parse) rather than one reported by gRPC.
+   */
+  void CloseWithClientError(const util::Status& status);
+
+  /**
+   * Pauses or resumes reading responses from the server, for subclasses that
+   * process responses asynchronously and need to bound how many are pending.
+   * Does nothing if the stream isn't started.
+   */
+  void SetReadsPaused(bool paused);
+
+  const std::shared_ptr<util::AsyncQueue>& worker_queue() const {
+    return worker_queue_;
+  }
+
+  /**
+   * The number of times this stream has been closed. Work that completes
+   * asynchronously should compare this against the value it started with and
+   * do nothing if the stream has been closed (and possibly restarted) since.
+   */
+  int close_count() const {
+    return close_count_;
+  }
+
   ExponentialBackoff backoff_;
 
  private:
@@ -16,6 +16,8 @@
 
 #include "Firestore/core/src/remote/watch_stream.h"
 
+#include <algorithm>
+#include <thread>
 #include <utility>
 
 #include "Firestore/core/src/model/mutation.h"
@@ -36,9 +38,38 @@ using local::TargetData;
 using model::TargetId;
 using remote::ByteBufferReader;
 using util::AsyncQueue;
+using util::Executor;
+using util::LogIsDebugEnabled;
 using util::Status;
 using util::TimerId;
 
+namespace {
+
+/**
+ * The number of responses that may be decoded or waiting for delivery at
+ * once. Once this many are outstanding, reads from gRPC are paused until the
+ * callback has caught up, so that HTTP/2 flow control holds back the server
+ * instead of responses piling up in memory.
+ */
+constexpr uint64_t kMaxResponsesInFlight = 32;
+
+int DecodeThreadCount() {
+  unsigned int hw_concurrency = std::thread::hardware_concurrency();
+  if (hw_concurrency == 0) {
+    // If the standard library doesn't know, guess something reasonable.
+    hw_concurrency = 4;
+  }
+  return static_cast<int>(std::min(hw_concurrency, 4u));
+}
+
+}  // namespace
+
+struct WatchStream::DecodedResponse {
+  Status status;
+  std::unique_ptr<WatchChange> change;
+  model::SnapshotVersion version;
+};
+
 WatchStream::WatchStream(
     const std::shared_ptr<AsyncQueue>& async_queue,
     std::shared_ptr<credentials::AuthCredentialsProvider>
@@ -55,14 +86,17 @@ WatchStream::WatchStream(
              TimerId::ListenStreamConnectionBackoff,
              TimerId::ListenStreamIdle,
              TimerId::HealthCheckTimeout},
-      watch_serializer_{std::move(serializer)},
-      callback_{NOT_NULL(callback)} {
+      watch_serializer_{
+          std::make_shared<WatchStreamSerializer>(std::move(serializer))},
+      callback_{NOT_NULL(callback)},
+      decode_executor_{Executor::CreateConcurrent(
+          "com.google.firebase.firestore.watch", DecodeThreadCount())} {
 }
 
 void WatchStream::WatchQuery(const TargetData& query) {
   EnsureOnQueue();
 
-  auto request = watch_serializer_.EncodeWatchRequest(query);
+  auto request = watch_serializer_->EncodeWatchRequest(query);
   LOG_DEBUG("%s watch: %s", GetDebugDescription(), request.ToString());
   Write(MakeByteBuffer(request));
 }
@@ -70,7 +104,7 @@ void WatchStream::WatchQuery(const TargetData& query) {
 void WatchStream::UnwatchTargetId(TargetId target_id) {
   EnsureOnQueue();
 
-  auto request = watch_serializer_.EncodeUnwatchRequest(target_id);
+  auto request = watch_serializer_->EncodeUnwatchRequest(target_id);
 
   LOG_DEBUG("%s unwatch: %s", GetDebugDescription(), request.ToString());
   Write(MakeByteBuffer(request));
@@ -89,32 +123,97 @@ void WatchStream::TearDown(GrpcStream* grpc_stream) {
 }
 
 void WatchStream::NotifyStreamOpen() {
+  next_response_id_ = 0;
+  next_delivery_id_ = 0;
+  decoded_responses_.clear();
+
   callback_->OnWatchStreamOpen();
 }
 
-Status WatchStream::NotifyStreamResponse(const grpc::ByteBuffer& message) {
+std::shared_ptr<WatchStream::DecodedResponse> WatchStream::DecodeResponse(
+    const WatchStreamSerializer& serializer,
+    const grpc::ByteBuffer& message,
+    const std::string& debug_description) {
+  auto result = std::make_shared<DecodedResponse>();
+
   ByteBufferReader reader{message};
-  auto response = watch_serializer_.ParseResponse(&reader);
-  if (!reader.ok()) {
-    return reader.status();
-  }
+  auto response = serializer.ParseResponse(&reader);
+  if (reader.ok()) {
+    LOG_DEBUG("%s response: %s", debug_description, response.ToString());
 
-  LOG_DEBUG("%s response: %s", GetDebugDescription(), response.ToString());
+    result->change = serializer.DecodeWatchChange(&reader, *response);
+    result->version = serializer.DecodeSnapshotVersion(&reader, *response);
+  }
+  result->status = reader.status();
+  return result;
+}
 
-  // A successful response means the stream is healthy.
-  backoff_.Reset();
+Status WatchStream::NotifyStreamResponse(const grpc::ByteBuffer& message) {
+  uint64_t response_id = next_response_id_++;
+  std::string debug_description =
+      LogIsDebugEnabled() ? GetDebugDescription() : std::string();
 
-  auto watch_change = watch_serializer_.DecodeWatchChange(&reader, *response);
-  auto version = watch_serializer_.DecodeSnapshotVersion(&reader, *response);
-  if (!reader.ok()) {
-    return reader.status();
+  if (next_response_id_ - next_delivery_id_ >= kMaxResponsesInFlight) {
+    SetReadsPaused(true);
   }
 
-  callback_->OnWatchStreamChange(*watch_change, version);
+  // The decode task must not touch the stream itself: it may finish after the
+  // stream has been closed or destroyed.
+  std::weak_ptr<Stream> weak_this{shared_from_this()};
+  std::shared_ptr<const WatchStreamSerializer> serializer = watch_serializer_;
+  std::shared_ptr<AsyncQueue> queue = worker_queue();
+  int initial_close_count = close_count();
+
+  // TODO(c++14): move `message` into the lambda.
+  decode_executor_->Execute([weak_this, serializer, queue, initial_close_count,
+                             response_id, message, debug_description] {
+    auto response = DecodeResponse(*serializer, message, debug_description);
+    queue->Enqueue([weak_this, initial_close_count, response_id, response] {
+      auto strong_this =
+          std::static_pointer_cast<WatchStream>(weak_this.lock());
+      if (!strong_this || strong_this->close_count() != initial_close_count) {
+        return;
+      }
+      strong_this->OnResponseDecoded(response_id, response);
+    });
+  });
 
   return Status::OK();
 }
 
+void WatchStream::OnResponseDecoded(uint64_t response_id,
+                                    std::shared_ptr<DecodedResponse> response) {
+  EnsureOnQueue();
+
+  decoded_responses_[response_id] = std::move(response);
+
+  int initial_close_count = close_count();
+  while (close_count() == initial_close_count) {
+    auto next = decoded_responses_.find(next_delivery_id_);
+    if (next == decoded_responses_.end()) {
+      return;
+    }
+    std::shared_ptr<DecodedResponse> decoded = std::move(next->second);
+    decoded_responses_.erase(next);
+    ++next_delivery_id_;
+
+    if (!decoded->status.ok()) {
+      CloseWithClientError(decoded->status);
+      return;
+    }
+
+    // A successful response means the stream is healthy.
+    backoff_.Reset();
+
+    if (next_response_id_ - next_delivery_id_ < kMaxResponsesInFlight) {
+      SetReadsPaused(false);
+    }
+
+    // Note: the callback may close the stream, which ends this loop.
+    callback_->OnWatchStreamChange(*decoded->change, decoded->version);
+  }
+}
+
 void WatchStream::NotifyStreamClose(const Status& status) {
   callback_->OnWatchStreamClose(status);
 }
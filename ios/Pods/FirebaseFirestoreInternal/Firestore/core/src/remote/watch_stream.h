@@ -17,6 +17,8 @@
 #ifndef FIRESTORE_CORE_SRC_REMOTE_WATCH_STREAM_H_
 #define FIRESTORE_CORE_SRC_REMOTE_WATCH_STREAM_H_
 
+#include <cstdint>
+#include <map>
 #include <memory>
 #include <string>
 
@@ -26,6 +28,7 @@
 #include "Firestore/core/src/remote/stream.h"
 #include "Firestore/core/src/remote/watch_change.h"
 #include "Firestore/core/src/util/async_queue.h"
+#include "Firestore/core/src/util/executor.h"
 #include "Firestore/core/src/util/status_fwd.h"
 #include "absl/strings/string_view.h"
 #include "grpcpp/support/byte_buffer.h"
@@ -80,6 +83,11 @@ class WatchStreamCallback {
  * Once the `WatchStream` has called the `OnWatchStreamOpen` method on the
  * callback, any number of `WatchQuery` and `UnwatchTargetId` calls can be sent
  * to control what changes will be sent from the server for WatchChanges.
+ *
+ * Responses are decoded on a pool of background threads so that large initial
+ * result sets don't serialize on the worker queue. Decoded changes are still
+ * delivered to the callback on the worker queue, in the order the responses
+ * were received.
  */
 class WatchStream : public Stream {
  public:
@@ -123,8 +131,35 @@ class WatchStream : public Stream {
     return "WatchStream";
   }
 
-  WatchStreamSerializer watch_serializer_;
+  struct DecodedResponse;
+
+  /**
+   * Parses and decodes a ListenResponse. Safe to call from any thread.
+   */
+  static std::shared_ptr<DecodedResponse> DecodeResponse(
+      const WatchStreamSerializer& serializer,
+      const grpc::ByteBuffer& message,
+      const std::string& debug_description);
+
+  /**
+   * Records the decoded response with the given sequence number, then hands
+   * every response whose predecessors have all been delivered to the callback.
+   */
+  void OnResponseDecoded(uint64_t response_id,
+                         std::shared_ptr<DecodedResponse> response);
+
+  // Shared with in-flight decode tasks, which may outlive the stream.
+  std::shared_ptr<const WatchStreamSerializer> watch_serializer_;
   WatchStreamCallback* callback_;
+
+  std::unique_ptr<util::Executor> decode_executor_;
+
+  // Responses are numbered in arrival order; `next_delivery_id_` is the number
+  // of the next response to hand to the callback. Both restart from zero
+  // whenever the stream opens.
+  uint64_t next_response_id_ = 0;
+  uint64_t next_delivery_id_ = 0;
+  std::map<uint64_t, std::shared_ptr<DecodedResponse>> decoded_responses_;
 };
 
 }  // namespace remote
@@ -19,6 +19,7 @@
 #include <utility>
 
 #include "Firestore/core/src/model/mutation.h"
+#include "Firestore/core/src/model/mutation_batch.h"
 #include "Firestore/core/src/nanopb/message.h"
 #include "Firestore/core/src/nanopb/reader.h"
 #include "Firestore/core/src/remote/grpc_nanopb.h"
@@ -33,6 +34,7 @@ namespace remote {
 using credentials::AuthCredentialsProvider;
 using credentials::AuthToken;
 using model::Mutation;
+using model::MutationBatch;
 using nanopb::ByteString;
 using nanopb::Message;
 using remote::ByteBufferReader;
@@ -40,6 +42,19 @@ using util::AsyncQueue;
 using util::Status;
 using util::TimerId;
 
+namespace {
+
+/**
+ * The encoded size past which no further batches are coalesced into a write
+ * request. Batches larger than this are still sent, on their own.
+ */
+constexpr size_t kMaxCoalescedRequestBytes = 256 * 1024;
+
+/** The backend rejects write requests with more writes than this. */
+constexpr size_t kMaxWritesPerRequest = 500;
+
+}  // namespace
+
 WriteStream::WriteStream(
     const std::shared_ptr<AsyncQueue>& async_queue,
     std::shared_ptr<credentials::AuthCredentialsProvider>
@@ -94,6 +109,24 @@ void WriteStream::WriteMutations(const std::vector<Mutation>& mutations) {
   Write(MakeByteBuffer(request));
 }
 
+size_t WriteStream::WriteMutationBatches(
+    absl::Span<const MutationBatch> batches) {
+  EnsureOnQueue();
+  HARD_ASSERT(IsOpen(), "Writing mutations requires an opened stream");
+  HARD_ASSERT(handshake_complete(),
+              "Handshake must be complete before writing mutations");
+  HARD_ASSERT(!batches.empty(), "Writing mutations requires a batch");
+
+  size_t batch_count = 0;
+  auto request = write_serializer_.EncodeWriteMutationBatchesRequest(
+      batches, kMaxCoalescedRequestBytes, kMaxWritesPerRequest,
+      last_stream_token(), &batch_count);
+  LOG_DEBUG("%s write request (%s batches): %s", GetDebugDescription(),
+            batch_count, request.ToString());
+  Write(MakeByteBuffer(request));
+  return batch_count;
+}
+
 std::unique_ptr<GrpcStream> WriteStream::CreateGrpcStream(
     GrpcConnection* grpc_connection,
     const AuthToken& auth_token,
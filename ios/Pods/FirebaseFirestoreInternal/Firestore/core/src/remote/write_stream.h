@@ -28,6 +28,7 @@
 #include "Firestore/core/src/util/async_queue.h"
 #include "Firestore/core/src/util/status_fwd.h"
 #include "absl/strings/string_view.h"
+#include "absl/types/span.h"
 #include "grpcpp/support/byte_buffer.h"
 
 namespace firebase {
@@ -129,6 +130,16 @@ class WriteStream : public Stream {
   /** Sends a group of mutations to the Firestore backend to apply. */
   virtual void WriteMutations(const std::vector<model::Mutation>& mutations);
 
+  /**
+   * Sends the mutations of as many leading `batches` as fit within the write
+   * request size limits as a single request, always including at least the
+   * first batch. The backend commits the request atomically and acknowledges
+   * it with a single response holding the results of every mutation, in
+   * order. Returns the number of batches sent.
+   */
+  virtual size_t WriteMutationBatches(
+      absl::Span<const model::MutationBatch> batches);
+
  protected:
   // For tests only
   void SetHandshakeComplete(bool value = true) {
@@ -73,7 +73,13 @@ enum class TimerId {
   /**
    * A timer used to periodically attempt Index Backfill
    */
-  IndexBackfillDelay
+  IndexBackfillDelay,
+
+  /**
+   * A timer used in `EventManager` to raise snapshots that were held back by a
+   * listener's minimum snapshot interval.
+   */
+  SnapshotDelivery
 };
 
 // A serial queue that executes given operations asynchronously, one at a time.
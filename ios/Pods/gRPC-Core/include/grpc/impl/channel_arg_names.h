@@ -67,6 +67,14 @@
    application will see the compressed message in the byte buffer. */
 #define GRPC_ARG_ENABLE_PER_MESSAGE_DECOMPRESSION \
   "grpc.per_message_decompression"
+/** Experimental Arg. Enable/disable adaptive per-message compression. When
+   enabled, a message that does not shrink by at least 10% makes its call
+   send its next messages uncompressed without trying, for a run that doubles
+   with each further miss (up to 64 messages). Only applies to calls using the
+   channel's default algorithm, never to calls that set one explicitly.
+   Defaults to 0. */
+#define GRPC_ARG_ADAPTIVE_PER_MESSAGE_COMPRESSION \
+  "grpc.experimental.adaptive_per_message_compression"
 /** Initial stream ID for http2 transports. Int valued. */
 #define GRPC_ARG_HTTP2_INITIAL_SEQUENCE_NUMBER \
   "grpc.http2.initial_sequence_number"
@@ -184,6 +192,15 @@
  *  protector.
  */
 #define GRPC_ARG_TSI_MAX_FRAME_SIZE "grpc.tsi.max_frame_size"
+/** If non-zero, TLS connections on Linux try to hand record encryption for
+ *  outgoing data to the kernel (kTLS) once the handshake completes, so that
+ *  writes go out as plaintext syscalls. Only TLS 1.2 and 1.3 sessions using
+ *  AES-GCM qualify; others, and kernels without kTLS, keep encrypting in user
+ *  space. Incoming data is always decrypted in user space. Ignored when
+ *  GRPC_ARG_TCP_TX_ZEROCOPY_ENABLED is set, since kTLS sockets reject
+ *  MSG_ZEROCOPY sends. Defaults to 0.
+ */
+#define GRPC_ARG_TLS_KERNEL_OFFLOAD "grpc.experimental.tls_kernel_offload"
 /** Maximum metadata size (soft limit), in bytes. Note this limit applies to the
    max sum of all metadata key-value entries in a batch of headers. Some random
    sample of requests between this limit and
@@ -30,6 +30,7 @@
 #include "absl/status/statusor.h"
 #include "absl/strings/escaping.h"
 #include "absl/strings/str_cat.h"
+#include "absl/strings/str_format.h"
 #include "absl/strings/strip.h"
 #include "src/core/channelz/channelz_registry.h"
 #include "src/core/lib/address_utils/parse_address.h"
@@ -568,6 +569,11 @@ void SocketNode::RecordMessageReceived() {
                                      std::memory_order_relaxed);
 }
 
+void SocketNode::RecordFlowControlState(const FlowControlState& state) {
+  MutexLock lock(&flow_control_mu_);
+  flow_control_state_ = state;
+}
+
 Json SocketNode::RenderJson() {
   // Create and fill the data child.
   Json::Object data;
@@ -630,6 +636,41 @@ Json SocketNode::RenderJson() {
   if (keepalives_sent != 0) {
     data["keepAlivesSent"] = Json::FromString(absl::StrCat(keepalives_sent));
   }
+  absl::optional<FlowControlState> flow_control_state;
+  {
+    MutexLock lock(&flow_control_mu_);
+    flow_control_state = flow_control_state_;
+  }
+  if (flow_control_state.has_value()) {
+    data["localFlowControlWindow"] =
+        Json::FromString(absl::StrCat(flow_control_state->local_window));
+    data["remoteFlowControlWindow"] =
+        Json::FromString(absl::StrCat(flow_control_state->remote_window));
+    // The rest of the model has no field of its own in SocketData, so it is
+    // reported the way transports report other tunables: as options.
+    auto option = [](absl::string_view name, std::string value) {
+      return Json::FromObject({
+          {"name", Json::FromString(std::string(name))},
+          {"value", Json::FromString(std::move(value))},
+      });
+    };
+    Json::Array options;
+    options.push_back(
+        option("grpc.http2.bdp_estimate",
+               absl::StrCat(flow_control_state->bdp_estimate)));
+    options.push_back(option(
+        "grpc.http2.bandwidth_estimate",
+        absl::StrFormat("%.0f", flow_control_state->bandwidth_estimate)));
+    if (flow_control_state->min_rtt_seconds > 0) {
+      options.push_back(option(
+          "grpc.http2.min_rtt",
+          absl::StrFormat("%.6fs", flow_control_state->min_rtt_seconds)));
+    }
+    options.push_back(option(
+        "grpc.http2.flow_control_stalled_time",
+        absl::StrFormat("%.3fs", flow_control_state->stalled_seconds)));
+    data["option"] = Json::FromArray(std::move(options));
+  }
   // Create and fill the parent object.
   Json::Object object = {
       {"ref", Json::FromObject({
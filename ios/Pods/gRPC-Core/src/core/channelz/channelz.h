@@ -385,6 +385,20 @@ class SocketNode final : public BaseNode {
     keepalives_sent_.fetch_add(1, std::memory_order_relaxed);
   }
 
+  // Flow control state of the transport using this socket, as last reported
+  // by the transport.
+  struct FlowControlState {
+    int64_t local_window = 0;
+    int64_t remote_window = 0;
+    int64_t bdp_estimate = 0;
+    // In bytes per second.
+    double bandwidth_estimate = 0;
+    // Zero until a round trip has been measured.
+    double min_rtt_seconds = 0;
+    double stalled_seconds = 0;
+  };
+  void RecordFlowControlState(const FlowControlState& state);
+
   const std::string& remote() { return remote_; }
 
  private:
@@ -398,6 +412,9 @@ class SocketNode final : public BaseNode {
   std::atomic<gpr_cycle_counter> last_remote_stream_created_cycle_{0};
   std::atomic<gpr_cycle_counter> last_message_sent_cycle_{0};
   std::atomic<gpr_cycle_counter> last_message_received_cycle_{0};
+  Mutex flow_control_mu_;
+  absl::optional<FlowControlState> flow_control_state_
+      ABSL_GUARDED_BY(flow_control_mu_);
   std::string local_;
   std::string remote_;
   RefCountedPtr<Security> const security_;
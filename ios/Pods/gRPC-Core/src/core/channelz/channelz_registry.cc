@@ -31,6 +31,7 @@
 
 #include "absl/log/check.h"
 #include "absl/log/log.h"
+#include "absl/strings/str_cat.h"
 #include "src/core/channelz/channelz.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
 #include "src/core/util/json/json.h"
@@ -41,7 +42,7 @@ namespace grpc_core {
 namespace channelz {
 namespace {
 
-const int kPaginationLimit = 100;
+const size_t kPaginationLimit = 100;
 
 }  // anonymous namespace
 
@@ -51,117 +52,113 @@ ChannelzRegistry* ChannelzRegistry::Default() {
 }
 
 void ChannelzRegistry::InternalRegister(BaseNode* node) {
-  MutexLock lock(&mu_);
-  node->uuid_ = ++uuid_generator_;
-  node_map_[node->uuid_] = node;
+  node->uuid_ = uuid_generator_.fetch_add(1, std::memory_order_relaxed) + 1;
+  NodeShard& shard = ShardFor(node->uuid_);
+  MutexLock lock(&shard.mu);
+  shard.node_map[node->uuid_] = node;
 }
 
 void ChannelzRegistry::InternalUnregister(intptr_t uuid) {
   CHECK_GE(uuid, 1);
-  MutexLock lock(&mu_);
-  CHECK(uuid <= uuid_generator_);
-  node_map_.erase(uuid);
+  CHECK(uuid <= uuid_generator_.load(std::memory_order_relaxed));
+  NodeShard& shard = ShardFor(uuid);
+  MutexLock lock(&shard.mu);
+  shard.node_map.erase(uuid);
 }
 
 RefCountedPtr<BaseNode> ChannelzRegistry::InternalGet(intptr_t uuid) {
-  MutexLock lock(&mu_);
-  if (uuid < 1 || uuid > uuid_generator_) {
+  if (uuid < 1 || uuid > uuid_generator_.load(std::memory_order_relaxed)) {
     return nullptr;
   }
-  auto it = node_map_.find(uuid);
-  if (it == node_map_.end()) return nullptr;
+  NodeShard& shard = ShardFor(uuid);
+  MutexLock lock(&shard.mu);
+  auto it = shard.node_map.find(uuid);
+  if (it == shard.node_map.end()) return nullptr;
   // Found node.  Return only if its refcount is not zero (i.e., when we
   // know that there is no other thread about to destroy it).
   BaseNode* node = it->second;
   return node->RefIfNonZero();
 }
 
-std::string ChannelzRegistry::InternalGetTopChannels(
-    intptr_t start_channel_id) {
-  std::vector<RefCountedPtr<BaseNode>> top_level_channels;
-  RefCountedPtr<BaseNode> node_after_pagination_limit;
-  {
-    MutexLock lock(&mu_);
-    for (auto it = node_map_.lower_bound(start_channel_id);
-         it != node_map_.end(); ++it) {
+std::vector<RefCountedPtr<BaseNode>> ChannelzRegistry::GetNodesOfType(
+    intptr_t start_id, BaseNode::EntityType type, size_t max_results) {
+  // Each shard is ordered by uuid, so the first max_results + 1 matches from
+  // every shard are enough to find the first max_results + 1 overall. Only
+  // one shard lock is held at a time. Refs we end up not using are dropped
+  // after all locks are released, since unreffing a node under the lock could
+  // deadlock.
+  std::vector<RefCountedPtr<BaseNode>> nodes;
+  for (NodeShard& shard : shards_) {
+    MutexLock lock(&shard.mu);
+    size_t found = 0;
+    for (auto it = shard.node_map.lower_bound(start_id);
+         it != shard.node_map.end() && found <= max_results; ++it) {
       BaseNode* node = it->second;
-      RefCountedPtr<BaseNode> node_ref;
-      if (node->type() == BaseNode::EntityType::kTopLevelChannel &&
-          (node_ref = node->RefIfNonZero()) != nullptr) {
-        // Check if we are over pagination limit to determine if we need to set
-        // the "end" element. If we don't go through this block, we know that
-        // when the loop terminates, we have <= to kPaginationLimit.
-        // Note that because we have already increased this node's
-        // refcount, we need to decrease it, but we can't unref while
-        // holding the lock, because this may lead to a deadlock.
-        if (top_level_channels.size() == kPaginationLimit) {
-          node_after_pagination_limit = std::move(node_ref);
-          break;
-        }
-        top_level_channels.emplace_back(std::move(node_ref));
-      }
-    }
-  }
-  Json::Object object;
-  if (!top_level_channels.empty()) {
-    // Create list of channels.
-    Json::Array array;
-    for (size_t i = 0; i < top_level_channels.size(); ++i) {
-      array.emplace_back(top_level_channels[i]->RenderJson());
+      if (node->type() != type) continue;
+      RefCountedPtr<BaseNode> node_ref = node->RefIfNonZero();
+      if (node_ref == nullptr) continue;
+      nodes.emplace_back(std::move(node_ref));
+      ++found;
     }
-    object["channel"] = Json::FromArray(std::move(array));
   }
-  if (node_after_pagination_limit == nullptr) {
-    object["end"] = Json::FromBool(true);
+  std::sort(nodes.begin(), nodes.end(),
+            [](const RefCountedPtr<BaseNode>& a,
+               const RefCountedPtr<BaseNode>& b) {
+              return a->uuid() < b->uuid();
+            });
+  if (nodes.size() > max_results + 1) {
+    nodes.erase(nodes.begin() + max_results + 1, nodes.end());
   }
-  return JsonDump(Json::FromObject(std::move(object)));
+  return nodes;
 }
 
-std::string ChannelzRegistry::InternalGetServers(intptr_t start_server_id) {
-  std::vector<RefCountedPtr<BaseNode>> servers;
-  RefCountedPtr<BaseNode> node_after_pagination_limit;
-  {
-    MutexLock lock(&mu_);
-    for (auto it = node_map_.lower_bound(start_server_id);
-         it != node_map_.end(); ++it) {
-      BaseNode* node = it->second;
-      RefCountedPtr<BaseNode> node_ref;
-      if (node->type() == BaseNode::EntityType::kServer &&
-          (node_ref = node->RefIfNonZero()) != nullptr) {
-        // Check if we are over pagination limit to determine if we need to set
-        // the "end" element. If we don't go through this block, we know that
-        // when the loop terminates, we have <= to kPaginationLimit.
-        // Note that because we have already increased this node's
-        // refcount, we need to decrease it, but we can't unref while
-        // holding the lock, because this may lead to a deadlock.
-        if (servers.size() == kPaginationLimit) {
-          node_after_pagination_limit = std::move(node_ref);
-          break;
-        }
-        servers.emplace_back(std::move(node_ref));
-      }
+std::string ChannelzRegistry::RenderPage(
+    const char* field, std::vector<RefCountedPtr<BaseNode>> nodes,
+    size_t max_results) {
+  // Check if we are over pagination limit to determine if we need to set
+  // the "end" element.
+  const bool end = nodes.size() <= max_results;
+  if (!end) nodes.pop_back();
+  // Produces exactly what JsonDump() would for the equivalent Json object:
+  // the list field sorts before "end".
+  std::string out = "{";
+  if (!nodes.empty()) {
+    absl::StrAppend(&out, "\"", field, "\":[");
+    for (size_t i = 0; i < nodes.size(); ++i) {
+      if (i != 0) out.push_back(',');
+      out.append(JsonDump(nodes[i]->RenderJson()));
+      nodes[i].reset();
     }
+    out.push_back(']');
+    if (end) out.push_back(',');
   }
-  Json::Object object;
-  if (!servers.empty()) {
-    // Create list of servers.
-    Json::Array array;
-    for (size_t i = 0; i < servers.size(); ++i) {
-      array.emplace_back(servers[i]->RenderJson());
-    }
-    object["server"] = Json::FromArray(std::move(array));
-  }
-  if (node_after_pagination_limit == nullptr) {
-    object["end"] = Json::FromBool(true);
-  }
-  return JsonDump(Json::FromObject(std::move(object)));
+  if (end) out.append("\"end\":true");
+  out.push_back('}');
+  return out;
+}
+
+std::string ChannelzRegistry::InternalGetTopChannels(
+    intptr_t start_channel_id) {
+  return RenderPage("channel",
+                    GetNodesOfType(start_channel_id,
+                                   BaseNode::EntityType::kTopLevelChannel,
+                                   kPaginationLimit),
+                    kPaginationLimit);
+}
+
+std::string ChannelzRegistry::InternalGetServers(intptr_t start_server_id) {
+  return RenderPage(
+      "server",
+      GetNodesOfType(start_server_id, BaseNode::EntityType::kServer,
+                     kPaginationLimit),
+      kPaginationLimit);
 }
 
 void ChannelzRegistry::InternalLogAllEntities() {
   std::vector<RefCountedPtr<BaseNode>> nodes;
-  {
-    MutexLock lock(&mu_);
-    for (auto& p : node_map_) {
+  for (NodeShard& shard : shards_) {
+    MutexLock lock(&shard.mu);
+    for (auto& p : shard.node_map) {
       RefCountedPtr<BaseNode> node = p.second->RefIfNonZero();
       if (node != nullptr) {
         nodes.emplace_back(std::move(node));
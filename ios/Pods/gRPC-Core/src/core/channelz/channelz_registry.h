@@ -21,9 +21,12 @@
 
 #include <grpc/support/port_platform.h>
 
+#include <array>
+#include <atomic>
 #include <cstdint>
 #include <map>
 #include <string>
+#include <vector>
 
 #include "absl/base/thread_annotations.h"
 #include "src/core/channelz/channelz.h"
@@ -35,6 +38,8 @@ namespace channelz {
 
 // singleton registry object to track all objects that are needed to support
 // channelz bookkeeping. All objects share globally distributed uuids.
+// Nodes are spread over independently locked shards by uuid, so that
+// registration under heavy connection churn does not serialize on one lock.
 class ChannelzRegistry final {
  public:
   static void Register(BaseNode* node) {
@@ -64,9 +69,11 @@ class ChannelzRegistry final {
   // Test only helper function to reset to initial state.
   static void TestOnlyReset() {
     auto* p = Default();
-    MutexLock lock(&p->mu_);
-    p->node_map_.clear();
-    p->uuid_generator_ = 0;
+    for (NodeShard& shard : p->shards_) {
+      MutexLock lock(&shard.mu);
+      shard.node_map.clear();
+    }
+    p->uuid_generator_.store(0, std::memory_order_relaxed);
   }
 
  private:
@@ -87,12 +94,33 @@ class ChannelzRegistry final {
   std::string InternalGetTopChannels(intptr_t start_channel_id);
   std::string InternalGetServers(intptr_t start_server_id);
 
+  // Returns refs to the first max_results + 1 live nodes of the given type
+  // with uuid >= start_id, in uuid order. The extra node, if present, only
+  // tells the caller that the page is not the last one.
+  std::vector<RefCountedPtr<BaseNode>> GetNodesOfType(intptr_t start_id,
+                                                      BaseNode::EntityType type,
+                                                      size_t max_results);
+
+  // Renders one page of a Get*Response, one node at a time, without
+  // building the whole response as a Json tree first.
+  static std::string RenderPage(const char* field,
+                                std::vector<RefCountedPtr<BaseNode>> nodes,
+                                size_t max_results);
+
   void InternalLogAllEntities();
 
-  // protects members
-  Mutex mu_;
-  std::map<intptr_t, BaseNode*> node_map_ ABSL_GUARDED_BY(mu_);
-  intptr_t uuid_generator_ ABSL_GUARDED_BY(mu_) = 0;
+  static constexpr size_t kNumShards = 16;
+  struct alignas(GPR_CACHELINE_SIZE) NodeShard {
+    // protects node_map
+    Mutex mu;
+    std::map<intptr_t, BaseNode*> node_map ABSL_GUARDED_BY(mu);
+  };
+  NodeShard& ShardFor(intptr_t uuid) {
+    return shards_[static_cast<uintptr_t>(uuid) % kNumShards];
+  }
+
+  std::array<NodeShard, kNumShards> shards_;
+  std::atomic<intptr_t> uuid_generator_{0};
 };
 
 }  // namespace channelz
@@ -21,6 +21,7 @@
 #include <grpc/support/port_platform.h>
 #include <inttypes.h>
 
+#include <algorithm>
 #include <functional>
 #include <memory>
 #include <utility>
@@ -93,7 +94,10 @@ ChannelCompression::ChannelCompression(const ChannelArgs& args)
           args.GetBool(GRPC_ARG_ENABLE_PER_MESSAGE_COMPRESSION).value_or(true)),
       enable_decompression_(
           args.GetBool(GRPC_ARG_ENABLE_PER_MESSAGE_DECOMPRESSION)
-              .value_or(true)) {
+              .value_or(true)),
+      enable_adaptive_compression_(
+          args.GetBool(GRPC_ARG_ADAPTIVE_PER_MESSAGE_COMPRESSION)
+              .value_or(false)) {
   // Make sure the default is enabled.
   if (!enabled_compression_algorithms_.IsSet(default_compression_algorithm_)) {
     const char* name;
@@ -107,8 +111,27 @@ ChannelCompression::ChannelCompression(const ChannelArgs& args)
   }
 }
 
-MessageHandle ChannelCompression::CompressMessage(
-    MessageHandle message, grpc_compression_algorithm algorithm) const {
+bool ChannelCompression::AdaptiveSkip::ShouldSkip() {
+  if (skip_remaining_ == 0) return false;
+  --skip_remaining_;
+  return true;
+}
+
+void ChannelCompression::AdaptiveSkip::Record(size_t before_size,
+                                              size_t after_size) {
+  // Worth it: at least 10% smaller.
+  if (after_size <= before_size - before_size / 10) {
+    backoff_ = 0;
+    return;
+  }
+  // Not worth it: skip the next messages, twice as many as last time.
+  backoff_ = backoff_ == 0 ? 1 : std::min(backoff_ * 2, kMaxSkip);
+  skip_remaining_ = backoff_;
+}
+
+MessageHandle ChannelCompression::CompressMessage(MessageHandle message,
+                                                 CompressArgs& args) const {
+  const grpc_compression_algorithm algorithm = args.algorithm;
   GRPC_TRACE_LOG(compression, INFO)
       << "CompressMessage: len=" << message->payload()->Length()
       << " alg=" << algorithm << " flags=" << message->flags();
@@ -124,11 +147,22 @@ MessageHandle ChannelCompression::CompressMessage(
       (flags & (GRPC_WRITE_NO_COMPRESS | GRPC_WRITE_INTERNAL_COMPRESS))) {
     return message;
   }
+  // Recent messages on this call did not compress: don't burn cycles trying
+  // again just yet.
+  if (args.adaptive && args.adaptive_skip.ShouldSkip()) {
+    GRPC_TRACE_LOG(compression, INFO)
+        << "CompressMessage: skipped, recent messages did not compress";
+    return message;
+  }
   // Try to compress the payload.
   SliceBuffer tmp;
   SliceBuffer* payload = message->payload();
   bool did_compress = grpc_msg_compress(algorithm, payload->c_slice_buffer(),
                                         tmp.c_slice_buffer());
+  if (args.adaptive) {
+    args.adaptive_skip.Record(payload->Length(),
+                              did_compress ? tmp.Length() : payload->Length());
+  }
   // If we achieved compression send it as compressed, otherwise send it as (to
   // avoid spending cycles on the receiver decompressing).
   if (did_compress) {
@@ -204,17 +238,23 @@ absl::StatusOr<MessageHandle> ChannelCompression::DecompressMessage(
   return std::move(message);
 }
 
-grpc_compression_algorithm ChannelCompression::HandleOutgoingMetadata(
+ChannelCompression::CompressArgs ChannelCompression::HandleOutgoingMetadata(
     grpc_metadata_batch& outgoing_metadata) {
-  const auto algorithm = outgoing_metadata.Take(GrpcInternalEncodingRequest())
-                             .value_or(default_compression_algorithm());
+  const auto requested_algorithm =
+      outgoing_metadata.Take(GrpcInternalEncodingRequest());
+  const auto algorithm =
+      requested_algorithm.value_or(default_compression_algorithm());
   // Convey supported compression algorithms.
   outgoing_metadata.Set(GrpcAcceptEncodingMetadata(),
                         enabled_compression_algorithms());
   if (algorithm != GRPC_COMPRESS_NONE) {
     outgoing_metadata.Set(GrpcEncodingMetadata(), algorithm);
   }
-  return algorithm;
+  // An algorithm the call asked for explicitly is always honored.
+  return CompressArgs{
+      algorithm,
+      enable_adaptive_compression_ && !requested_algorithm.has_value(),
+      AdaptiveSkip()};
 }
 
 ChannelCompression::DecompressArgs ChannelCompression::HandleIncomingMetadata(
@@ -238,8 +278,7 @@ void ClientCompressionFilter::Call::OnClientInitialMetadata(
     ClientMetadata& md, ClientCompressionFilter* filter) {
   GRPC_LATENT_SEE_INNER_SCOPE(
       "ClientCompressionFilter::Call::OnClientInitialMetadata");
-  compression_algorithm_ =
-      filter->compression_engine_.HandleOutgoingMetadata(md);
+  compress_args_ = filter->compression_engine_.HandleOutgoingMetadata(md);
 }
 
 MessageHandle ClientCompressionFilter::Call::OnClientToServerMessage(
@@ -247,7 +286,7 @@ MessageHandle ClientCompressionFilter::Call::OnClientToServerMessage(
   GRPC_LATENT_SEE_INNER_SCOPE(
       "ClientCompressionFilter::Call::OnClientToServerMessage");
   return filter->compression_engine_.CompressMessage(std::move(message),
-                                                     compression_algorithm_);
+                                                     compress_args_);
 }
 
 void ClientCompressionFilter::Call::OnServerInitialMetadata(
@@ -286,8 +325,7 @@ void ServerCompressionFilter::Call::OnServerInitialMetadata(
     ServerMetadata& md, ServerCompressionFilter* filter) {
   GRPC_LATENT_SEE_INNER_SCOPE(
       "ServerCompressionFilter::Call::OnServerInitialMetadata");
-  compression_algorithm_ =
-      filter->compression_engine_.HandleOutgoingMetadata(md);
+  compress_args_ = filter->compression_engine_.HandleOutgoingMetadata(md);
 }
 
 MessageHandle ServerCompressionFilter::Call::OnServerToClientMessage(
@@ -295,7 +333,7 @@ MessageHandle ServerCompressionFilter::Call::OnServerToClientMessage(
   GRPC_LATENT_SEE_INNER_SCOPE(
       "ServerCompressionFilter::Call::OnServerToClientMessage");
   return filter->compression_engine_.CompressMessage(std::move(message),
-                                                     compression_algorithm_);
+                                                     compress_args_);
 }
 
 }  // namespace grpc_core
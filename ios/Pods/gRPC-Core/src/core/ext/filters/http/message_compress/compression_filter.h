@@ -63,6 +63,31 @@ class ChannelCompression {
  public:
   explicit ChannelCompression(const ChannelArgs& args);
 
+  // Skips compression on calls whose recent messages did not compress, e.g.
+  // ones carrying already-compressed media. Each call tracks its own.
+  class AdaptiveSkip {
+   public:
+    // Returns true if the next message should be sent without trying to
+    // compress it.
+    bool ShouldSkip();
+    // Records the outcome of an attempt: before and after sizes in bytes.
+    void Record(size_t before_size, size_t after_size);
+
+   private:
+    static constexpr uint32_t kMaxSkip = 64;
+    uint32_t skip_remaining_ = 0;
+    uint32_t backoff_ = 0;
+  };
+
+  struct CompressArgs {
+    grpc_compression_algorithm algorithm;
+    // Whether to skip compression adaptively. Only set if enabled on the
+    // channel and the algorithm is the channel default rather than one the
+    // call asked for.
+    bool adaptive;
+    AdaptiveSkip adaptive_skip;
+  };
+
   struct DecompressArgs {
     grpc_compression_algorithm algorithm;
     absl::optional<uint32_t> max_recv_message_length;
@@ -76,14 +101,13 @@ class ChannelCompression {
     return enabled_compression_algorithms_;
   }
 
-  grpc_compression_algorithm HandleOutgoingMetadata(
-      grpc_metadata_batch& outgoing_metadata);
+  CompressArgs HandleOutgoingMetadata(grpc_metadata_batch& outgoing_metadata);
   DecompressArgs HandleIncomingMetadata(
       const grpc_metadata_batch& incoming_metadata);
 
   // Compress one message synchronously.
   MessageHandle CompressMessage(MessageHandle message,
-                                grpc_compression_algorithm algorithm) const;
+                                CompressArgs& args) const;
   // Decompress one message synchronously.
   absl::StatusOr<MessageHandle> DecompressMessage(bool is_client,
                                                   MessageHandle message,
@@ -101,6 +125,8 @@ class ChannelCompression {
   bool enable_compression_;
   // Is decompression enabled?
   bool enable_decompression_;
+  // Is adaptive compression enabled for calls using the default algorithm?
+  bool enable_adaptive_compression_;
 };
 
 class ClientCompressionFilter final
@@ -134,7 +160,7 @@ class ClientCompressionFilter final
     static const NoInterceptor OnFinalize;
 
    private:
-    grpc_compression_algorithm compression_algorithm_;
+    ChannelCompression::CompressArgs compress_args_;
     ChannelCompression::DecompressArgs decompress_args_;
   };
 
@@ -174,7 +200,7 @@ class ServerCompressionFilter final
 
    private:
     ChannelCompression::DecompressArgs decompress_args_;
-    grpc_compression_algorithm compression_algorithm_;
+    ChannelCompression::CompressArgs compress_args_;
   };
 
  private:
@@ -1079,6 +1079,7 @@ static void write_action_begin_locked(
 }
 
 static void write_action(grpc_chttp2_transport* t) {
+  GRPC_LATENT_SEE_INNER_SCOPE("write_action");
   void* cl = t->context_list;
   if (!t->context_list->empty()) {
     // Transfer the ownership of the context list to the endpoint and create and
@@ -2718,6 +2719,19 @@ void grpc_chttp2_act_on_flowctl_action(
   }
 }
 
+void grpc_chttp2_report_flow_control_to_channelz(grpc_chttp2_transport* t) {
+  if (t->channelz_socket == nullptr) return;
+  const grpc_core::BdpEstimator* bdp = t->flow_control.bdp_estimator();
+  grpc_core::channelz::SocketNode::FlowControlState state;
+  state.local_window = t->flow_control.announced_window();
+  state.remote_window = t->flow_control.remote_window();
+  state.bdp_estimate = bdp->EstimateBdp();
+  state.bandwidth_estimate = bdp->EstimateBandwidth();
+  state.min_rtt_seconds = bdp->MinRttSeconds();
+  state.stalled_seconds = t->flow_control.stalled_time().seconds();
+  t->channelz_socket->RecordFlowControlState(state);
+}
+
 static grpc_error_handle try_http_parsing(grpc_chttp2_transport* t) {
   grpc_http_parser parser;
   size_t i = 0;
@@ -2940,6 +2954,7 @@ static void finish_bdp_ping_locked(
       t->flow_control.bdp_estimator()->CompletePing();
   grpc_chttp2_act_on_flowctl_action(t->flow_control.PeriodicUpdate(), t.get(),
                                     nullptr);
+  grpc_chttp2_report_flow_control_to_channelz(t.get());
   CHECK(t->next_bdp_ping_timer_handle == TaskHandle::kInvalid);
   t->next_bdp_ping_timer_handle =
       t->event_engine->RunAfter(next_ping - grpc_core::Timestamp::Now(), [t] {
@@ -171,6 +171,14 @@ FlowControlAction TransportFlowControl::UpdateAction(FlowControlAction action) {
   return action;
 }
 
+int64_t TransportFlowControl::target_stream_window_delta() const {
+  if (!enable_bdp_probe_) return kMaxWindowDelta;
+  // Same gain as the transport window: twice the estimate keeps the pipe full
+  // while the next window update is in flight.
+  return Clamp(2 * bdp_estimator_.EstimateBdp(), kMaxWindowDelta,
+               static_cast<int64_t>(kMaxInitialWindowSize));
+}
+
 double
 TransportFlowControl::TargetInitialWindowSizeBasedOnMemoryPressureAndBdp()
     const {
@@ -325,7 +333,9 @@ std::string TransportFlowControl::Stats::ToString() const {
                       announced_stream_total_over_incoming_window,
                       " bdp_accumulator: ", bdp_accumulator,
                       " bdp_estimate: ", bdp_estimate,
-                      " bdp_bw_est: ", bdp_bw_est);
+                      " bdp_bw_est: ", bdp_bw_est,
+                      " bdp_min_rtt: ", bdp_min_rtt.ToString(),
+                      " stalled_time: ", stalled_time.ToString());
 }
 
 void StreamFlowControl::SentUpdate(uint32_t announce) {
@@ -346,7 +356,7 @@ uint32_t StreamFlowControl::DesiredAnnounceSize() const {
         return announced_window_delta_;
       }
     } else {
-      return std::min(min_progress_size_, kMaxWindowDelta);
+      return std::min(min_progress_size_, tfc_->target_stream_window_delta());
     }
   }();
   return Clamp(desired_window_delta - announced_window_delta_, int64_t{0},
@@ -230,10 +230,25 @@ class TransportFlowControl final {
   class OutgoingUpdateContext {
    public:
     explicit OutgoingUpdateContext(TransportFlowControl* tfc) : tfc_(tfc) {}
-    void StreamSentData(int64_t size) { tfc_->remote_window_ -= size; }
+    void StreamSentData(int64_t size) {
+      const bool was_stalled = tfc_->remote_window_ <= 0;
+      tfc_->remote_window_ -= size;
+      if (!was_stalled && tfc_->remote_window_ <= 0) {
+        tfc_->stalled_since_ = Timestamp::Now();
+      }
+    }
 
     // we have received a WINDOW_UPDATE frame for a transport
-    void RecvUpdate(uint32_t size) { tfc_->remote_window_ += size; }
+    void RecvUpdate(uint32_t size) {
+      const bool was_stalled = tfc_->remote_window_ <= 0;
+      tfc_->remote_window_ += size;
+      if (was_stalled && tfc_->remote_window_ > 0 &&
+          tfc_->stalled_since_ != Timestamp::InfFuture()) {
+        tfc_->last_stall_ = Timestamp::Now() - tfc_->stalled_since_;
+        tfc_->stalled_time_ += tfc_->last_stall_;
+        tfc_->stalled_since_ = Timestamp::InfFuture();
+      }
+    }
 
     // Finish the update and check whether we became stalled or unstalled.
     StallEdge Finish() {
@@ -262,6 +277,22 @@ class TransportFlowControl final {
   }
 
   BdpEstimator* bdp_estimator() { return &bdp_estimator_; }
+  const BdpEstimator* bdp_estimator() const { return &bdp_estimator_; }
+
+  // How far past its announced window a stream may be credited when a reader
+  // is waiting. Follows the BDP estimate so that a single bulk stream can fill
+  // the pipe instead of stalling every kMaxWindowDelta bytes.
+  int64_t target_stream_window_delta() const;
+
+  // Total time our sends have been blocked on the peer's transport window,
+  // including a stall that is still ongoing.
+  Duration stalled_time() const {
+    return stalled_since_ == Timestamp::InfFuture()
+               ? stalled_time_
+               : stalled_time_ + (Timestamp::Now() - stalled_since_);
+  }
+  // Length of the most recent stall that has ended.
+  Duration last_stall() const { return last_stall_; }
 
   uint32_t acked_init_window() const { return acked_init_window_; }
   uint32_t queued_init_window() const { return target_initial_window_size_; }
@@ -300,6 +331,8 @@ class TransportFlowControl final {
     int64_t bdp_accumulator;
     int64_t bdp_estimate;
     double bdp_bw_est;
+    Duration bdp_min_rtt;
+    Duration stalled_time;
 
     std::string ToString() const;
   };
@@ -320,6 +353,8 @@ class TransportFlowControl final {
     stats.bdp_accumulator = bdp_estimator_.accumulator();
     stats.bdp_estimate = bdp_estimator_.EstimateBdp();
     stats.bdp_bw_est = bdp_estimator_.EstimateBandwidth();
+    stats.bdp_min_rtt = bdp_estimator_.MinRtt();
+    stats.stalled_time = stalled_time();
     return stats;
   }
 
@@ -359,6 +394,10 @@ class TransportFlowControl final {
   int64_t announced_window_ = kDefaultWindow;
   uint32_t acked_init_window_ = kDefaultWindow;
   uint32_t sent_init_window_ = kDefaultWindow;
+  // When the remote window last dropped to zero, or InfFuture if it is open.
+  Timestamp stalled_since_ = Timestamp::InfFuture();
+  Duration stalled_time_;
+  Duration last_stall_;
 };
 
 // Implementation of flow control that abides to HTTP/2 spec and attempts
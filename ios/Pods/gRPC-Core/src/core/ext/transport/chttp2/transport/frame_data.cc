@@ -54,14 +54,13 @@ absl::Status grpc_chttp2_data_parser_begin_frame(uint8_t flags,
 void grpc_chttp2_encode_data(uint32_t id, grpc_slice_buffer* inbuf,
                              uint32_t write_bytes, int is_eof,
                              grpc_core::CallTracerInterface* call_tracer,
+                             grpc_core::Chttp2WriteArena* arena,
                              grpc_slice_buffer* outbuf) {
-  grpc_slice hdr;
   uint8_t* p;
   static const size_t header_size = 9;
 
-  hdr = GRPC_SLICE_MALLOC(header_size);
-  p = GRPC_SLICE_START_PTR(hdr);
   CHECK(write_bytes < (1 << 24));
+  p = arena->Append(header_size, outbuf);
   *p++ = static_cast<uint8_t>(write_bytes >> 16);
   *p++ = static_cast<uint8_t>(write_bytes >> 8);
   *p++ = static_cast<uint8_t>(write_bytes);
@@ -71,9 +70,8 @@ void grpc_chttp2_encode_data(uint32_t id, grpc_slice_buffer* inbuf,
   *p++ = static_cast<uint8_t>(id >> 16);
   *p++ = static_cast<uint8_t>(id >> 8);
   *p++ = static_cast<uint8_t>(id);
-  grpc_slice_buffer_add(outbuf, hdr);
 
-  grpc_slice_buffer_move_first_no_ref(inbuf, write_bytes, outbuf);
+  arena->MoveFirst(inbuf, write_bytes, outbuf);
 
   call_tracer->RecordOutgoingBytes({header_size, 0, 0});
 }
@@ -27,6 +27,7 @@
 
 #include "absl/status/status.h"
 #include "src/core/ext/transport/chttp2/transport/legacy_frame.h"
+#include "src/core/ext/transport/chttp2/transport/write_arena.h"
 #include "src/core/lib/iomgr/error.h"
 #include "src/core/lib/promise/poll.h"
 #include "src/core/lib/slice/slice_buffer.h"
@@ -46,9 +47,12 @@ grpc_error_handle grpc_chttp2_data_parser_parse(void* parser,
                                                 const grpc_slice& slice,
                                                 int is_last);
 
+// Frame the first write_bytes of inbuf as a DATA frame onto outbuf. The frame
+// header and small payload fragments are staged in arena.
 void grpc_chttp2_encode_data(uint32_t id, grpc_slice_buffer* inbuf,
                              uint32_t write_bytes, int is_eof,
                              grpc_core::CallTracerInterface* call_tracer,
+                             grpc_core::Chttp2WriteArena* arena,
                              grpc_slice_buffer* outbuf);
 
 grpc_core::Poll<grpc_error_handle> grpc_deframe_unprocessed_incoming_frames(
@@ -30,6 +30,7 @@
 #include "src/core/ext/transport/chttp2/transport/internal.h"
 #include "src/core/ext/transport/chttp2/transport/stream_lists.h"
 #include "src/core/telemetry/stats.h"
+#include "src/core/util/latent_see.h"
 #include "src/core/util/time.h"
 
 grpc_slice grpc_chttp2_window_update_create(
@@ -133,6 +134,10 @@ grpc_error_handle grpc_chttp2_window_update_parser_parse(
           received_update);
       upd.RecvUpdate(received_update);
       if (upd.Finish() == grpc_core::chttp2::StallEdge::kUnstalled) {
+        GRPC_LATENT_SEE_STALL(
+            "chttp2 transport flow control",
+            std::chrono::milliseconds(t->flow_control.last_stall().millis()));
+        grpc_chttp2_report_flow_control_to_channelz(t);
         grpc_chttp2_initiate_write(
             t, GRPC_CHTTP2_INITIATE_WRITE_TRANSPORT_FLOW_CONTROL_UNSTALLED);
       }
@@ -55,6 +55,7 @@
 #include "src/core/ext/transport/chttp2/transport/ping_abuse_policy.h"
 #include "src/core/ext/transport/chttp2/transport/ping_callbacks.h"
 #include "src/core/ext/transport/chttp2/transport/ping_rate_policy.h"
+#include "src/core/ext/transport/chttp2/transport/write_arena.h"
 #include "src/core/ext/transport/chttp2/transport/write_size_policy.h"
 #include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/debug/trace.h"
@@ -350,6 +351,8 @@ struct grpc_chttp2_transport final : public grpc_core::FilterStackTransport,
 
   /// data to write now
   grpc_core::SliceBuffer outbuf;
+  /// frame headers and small payload fragments referenced by outbuf
+  grpc_core::Chttp2WriteArena write_arena;
   /// hpack encoding
   grpc_core::HPackCompressor hpack_compressor;
 
@@ -755,6 +758,10 @@ void grpc_chttp2_act_on_flowctl_action(
     const grpc_core::chttp2::FlowControlAction& action,
     grpc_chttp2_transport* t, grpc_chttp2_stream* s);
 
+// Publishes the transport's flow control state (windows, BDP model and stall
+// time) to its channelz socket, if it has one.
+void grpc_chttp2_report_flow_control_to_channelz(grpc_chttp2_transport* t);
+
 //******** End of Flow Control **************
 
 inline grpc_chttp2_stream* grpc_chttp2_parsing_lookup_stream(
@@ -0,0 +1,58 @@
+// Copyright 2024 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/core/ext/transport/chttp2/transport/write_arena.h"
+
+#include <grpc/support/port_platform.h>
+
+#include <algorithm>
+
+#include "absl/log/check.h"
+
+namespace grpc_core {
+
+uint8_t* Chttp2WriteArena::Append(size_t n, grpc_slice_buffer* out) {
+  if (GRPC_SLICE_LENGTH(chunk_) - used_ < n) {
+    // Bytes already handed out stay alive through the slices that reference
+    // them; we only drop our own ref.
+    CSliceUnref(chunk_);
+    chunk_ = GRPC_SLICE_MALLOC(std::max(n, kChunkSize));
+    used_ = 0;
+  }
+  grpc_slice piece =
+      grpc_slice_sub_no_ref(CSliceRef(chunk_), used_, used_ + n);
+  uint8_t* p = GRPC_SLICE_START_PTR(piece);
+  used_ += n;
+  // Merges with the previous piece if it ends where this one starts.
+  grpc_slice_buffer_add(out, piece);
+  return p;
+}
+
+void Chttp2WriteArena::MoveFirst(grpc_slice_buffer* in, size_t n,
+                                 grpc_slice_buffer* out) {
+  CHECK_GE(in->length, n);
+  while (n > 0) {
+    const size_t take = std::min(n, GRPC_SLICE_LENGTH(in->slices[0]));
+    if (take == 0) {
+      CSliceUnref(grpc_slice_buffer_take_first(in));
+    } else if (take <= kMaxCopySize) {
+      grpc_slice_buffer_move_first_into_buffer(in, take, Append(take, out));
+    } else {
+      grpc_slice_buffer_move_first_no_ref(in, take, out);
+    }
+    n -= take;
+  }
+}
+
+}  // namespace grpc_core
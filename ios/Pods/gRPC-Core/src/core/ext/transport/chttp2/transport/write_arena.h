@@ -0,0 +1,62 @@
+// Copyright 2024 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GRPC_SRC_CORE_EXT_TRANSPORT_CHTTP2_TRANSPORT_WRITE_ARENA_H
+#define GRPC_SRC_CORE_EXT_TRANSPORT_CHTTP2_TRANSPORT_WRITE_ARENA_H
+
+#include <grpc/slice.h>
+#include <grpc/slice_buffer.h>
+#include <grpc/support/port_platform.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "src/core/lib/slice/slice.h"
+
+namespace grpc_core {
+
+// Backing store for the small pieces the transport writes between payload
+// slices: frame headers, and payload fragments too short to be worth an
+// iovec of their own.
+// Consecutive pieces are carved out of one refcounted chunk, so
+// grpc_slice_buffer_add merges them into a single slice of the outgoing
+// buffer. Larger payload slices are still referenced in place.
+class Chttp2WriteArena {
+ public:
+  // Payload fragments up to this size are copied rather than referenced.
+  static constexpr size_t kMaxCopySize = 256;
+  // Size of each chunk the arena carves pieces out of.
+  static constexpr size_t kChunkSize = 4096;
+
+  Chttp2WriteArena() = default;
+  ~Chttp2WriteArena() { CSliceUnref(chunk_); }
+
+  Chttp2WriteArena(const Chttp2WriteArena&) = delete;
+  Chttp2WriteArena& operator=(const Chttp2WriteArena&) = delete;
+
+  // Append n bytes to out and return where to write them.
+  // The pointer stays valid until the next call.
+  uint8_t* Append(size_t n, grpc_slice_buffer* out);
+  // Move the first n bytes of in to out: fragments no longer than
+  // kMaxCopySize are copied into the arena, the rest are moved by reference.
+  void MoveFirst(grpc_slice_buffer* in, size_t n, grpc_slice_buffer* out);
+
+ private:
+  grpc_slice chunk_ = slice_detail::EmptySlice();
+  // Bytes of chunk_ already handed out.
+  size_t used_ = 0;
+};
+
+}  // namespace grpc_core
+
+#endif  // GRPC_SRC_CORE_EXT_TRANSPORT_CHTTP2_TRANSPORT_WRITE_ARENA_H
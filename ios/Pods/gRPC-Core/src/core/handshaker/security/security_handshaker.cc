@@ -59,6 +59,7 @@
 #include "src/core/lib/slice/slice_internal.h"
 #include "src/core/telemetry/stats.h"
 #include "src/core/telemetry/stats_data.h"
+#include "src/core/tsi/ssl_transport_security.h"
 #include "src/core/tsi/transport_security_grpc.h"
 #include "src/core/util/debug_location.h"
 #include "src/core/util/ref_counted_ptr.h"
@@ -125,6 +126,7 @@ class SecurityHandshaker : public Handshaker {
   RefCountedPtr<grpc_auth_context> auth_context_;
   tsi_handshaker_result* handshaker_result_ = nullptr;
   size_t max_frame_size_ = 0;
+  const bool kernel_tls_offload_;
   std::string tsi_handshake_error_;
   grpc_closure* on_peer_checked_ ABSL_GUARDED_BY(mu_) = nullptr;
 };
@@ -138,7 +140,12 @@ SecurityHandshaker::SecurityHandshaker(tsi_handshaker* handshaker,
       handshake_buffer_(
           static_cast<uint8_t*>(gpr_malloc(handshake_buffer_size_))),
       max_frame_size_(
-          std::max(0, args.GetInt(GRPC_ARG_TSI_MAX_FRAME_SIZE).value_or(0))) {}
+          std::max(0, args.GetInt(GRPC_ARG_TSI_MAX_FRAME_SIZE).value_or(0))),
+      // Software kTLS rejects MSG_ZEROCOPY sends with EOPNOTSUPP, which
+      // would fail every write on the connection.
+      kernel_tls_offload_(
+          args.GetBool(GRPC_ARG_TLS_KERNEL_OFFLOAD).value_or(false) &&
+          !args.GetBool(GRPC_ARG_TCP_TX_ZEROCOPY_ENABLED).value_or(false)) {}
 
 SecurityHandshaker::~SecurityHandshaker() {
   tsi_handshaker_destroy(handshaker_);
@@ -241,6 +248,21 @@ void SecurityHandshaker::OnPeerCheckedFn(grpc_error_handle error) {
                      tsi_result_to_string(result), ")")));
     return;
   }
+  // Hand outgoing record encryption to the kernel if asked to. This has to
+  // happen before the protector takes over the TLS session; on failure the
+  // socket is unchanged and the protector handles both directions.
+  bool kernel_tls_tx = false;
+  if (kernel_tls_offload_ && frame_protector_type != TSI_FRAME_PROTECTOR_NONE) {
+    int fd = grpc_endpoint_get_fd(args_->endpoint.get());
+    result = tsi_ssl_handshaker_result_enable_kernel_tls_tx(handshaker_result_,
+                                                            fd);
+    kernel_tls_tx = result == TSI_OK;
+    GRPC_TRACE_LOG(handshaker, INFO)
+        << "Security handshake: kernel TLS offload for writes "
+        << (kernel_tls_tx ? "enabled"
+                          : absl::StrCat("unavailable (",
+                                         tsi_result_to_string(result), ")"));
+  }
   tsi_zero_copy_grpc_protector* zero_copy_protector = nullptr;
   tsi_frame_protector* protector = nullptr;
   switch (frame_protector_type) {
@@ -282,12 +304,12 @@ void SecurityHandshaker::OnPeerCheckedFn(grpc_error_handle error) {
           reinterpret_cast<const char*>(unused_bytes), unused_bytes_size);
       args_->endpoint = grpc_secure_endpoint_create(
           protector, zero_copy_protector, std::move(args_->endpoint), &slice,
-          args_->args.ToC().get(), 1);
+          args_->args.ToC().get(), 1, kernel_tls_tx);
       CSliceUnref(slice);
     } else {
       args_->endpoint = grpc_secure_endpoint_create(
           protector, zero_copy_protector, std::move(args_->endpoint), nullptr,
-          args_->args.ToC().get(), 0);
+          args_->args.ToC().get(), 0, kernel_tls_tx);
     }
   } else if (unused_bytes_size > 0) {
     // Not wrapping the endpoint, so just pass along unused bytes.
@@ -30,10 +30,17 @@
 #include "src/core/lib/slice/slice.h"
 
 #define OUTPUT_BLOCK_SIZE 1024
+// Once this much input has been deflated, give up if the output is still
+// more than 7/8 of the input: the rest of the message is unlikely to make up
+// for it, and the result would mostly be thrown away by the caller.
+#define COMPRESS_PROBE_SIZE (256 * 1024)
 
+// If max_output is non-zero, fails as soon as the output reaches max_output
+// bytes (or the probe above trips) instead of finishing the stream.
 static int zlib_body(z_stream* zs, grpc_slice_buffer* input,
                      grpc_slice_buffer* output,
-                     int (*flate)(z_stream* zs, int flush)) {
+                     int (*flate)(z_stream* zs, int flush),
+                     size_t max_output) {
   int r = Z_STREAM_END;  // Do not fail on an empty input.
   int flush;
   size_t i;
@@ -51,6 +58,13 @@ static int zlib_body(z_stream* zs, grpc_slice_buffer* input,
     zs->next_in = GRPC_SLICE_START_PTR(input->slices[i]);
     do {
       if (zs->avail_out == 0) {
+        if (max_output != 0 &&
+            (zs->total_out >= max_output ||
+             (zs->total_in >= COMPRESS_PROBE_SIZE &&
+              zs->total_out * 8 >= zs->total_in * 7))) {
+          VLOG(2) << "zlib: output not smaller than input, giving up";
+          goto error;
+        }
         grpc_slice_buffer_add_indexed(output, outbuf);
         outbuf = GRPC_SLICE_MALLOC(OUTPUT_BLOCK_SIZE);
         CHECK(GRPC_SLICE_LENGTH(outbuf) <= uint_max);
@@ -104,7 +118,8 @@ static int zlib_compress(grpc_slice_buffer* input, grpc_slice_buffer* output,
   r = deflateInit2(&zs, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 | (gzip ? 16 : 0),
                    8, Z_DEFAULT_STRATEGY);
   CHECK(r == Z_OK);
-  r = zlib_body(&zs, input, output, deflate) && output->length < input->length;
+  r = zlib_body(&zs, input, output, deflate, input->length) &&
+      output->length < input->length;
   if (!r) {
     for (i = count_before; i < output->count; i++) {
       grpc_core::CSliceUnref(output->slices[i]);
@@ -128,7 +143,7 @@ static int zlib_decompress(grpc_slice_buffer* input, grpc_slice_buffer* output,
   zs.zfree = zfree_gpr;
   r = inflateInit2(&zs, 15 | (gzip ? 16 : 0));
   CHECK(r == Z_OK);
-  r = zlib_body(&zs, input, output, inflate);
+  r = zlib_body(&zs, input, output, inflate, 0);
   if (!r) {
     for (i = count_before; i < output->count; i++) {
       grpc_core::CSliceUnref(output->slices[i]);
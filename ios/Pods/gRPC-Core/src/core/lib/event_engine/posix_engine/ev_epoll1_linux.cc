@@ -47,6 +47,7 @@
 #include "src/core/lib/event_engine/posix_engine/wakeup_fd_posix.h"
 #include "src/core/lib/event_engine/posix_engine/wakeup_fd_posix_default.h"
 #include "src/core/util/fork.h"
+#include "src/core/util/latent_see.h"
 #include "src/core/util/status_helper.h"
 #include "src/core/util/strerror.h"
 #include "src/core/util/sync.h"
@@ -428,6 +429,7 @@ EventHandle* Epoll1Poller::CreateHandle(int fd, absl::string_view /*name*/,
 // on file descriptors that became readable/writable.
 bool Epoll1Poller::ProcessEpollEvents(int max_epoll_events_to_handle,
                                       Events& pending_events) {
+  GRPC_LATENT_SEE_PARENT_SCOPE("Epoll1Poller::ProcessEpollEvents");
   int64_t num_events = g_epoll_set_.num_events;
   int64_t cursor = g_epoll_set_.cursor;
   bool was_kicked = false;
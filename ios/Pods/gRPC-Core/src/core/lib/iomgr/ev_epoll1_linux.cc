@@ -53,6 +53,7 @@
 #include "src/core/lib/iomgr/wakeup_fd_posix.h"
 #include "src/core/telemetry/stats.h"
 #include "src/core/telemetry/stats_data.h"
+#include "src/core/util/latent_see.h"
 #include "src/core/util/manual_constructor.h"
 #include "src/core/util/strerror.h"
 #include "src/core/util/string.h"
@@ -659,6 +660,7 @@ static int poll_deadline_to_millis_timeout(grpc_core::Timestamp millis) {
 // called by g_active_poller thread. So there is no need for synchronization
 // when accessing fields in g_epoll_set
 static grpc_error_handle process_epoll_events(grpc_pollset* /*pollset*/) {
+  GRPC_LATENT_SEE_PARENT_SCOPE("process_epoll_events");
   static const char* err_desc = "process_events";
   grpc_error_handle error;
   long num_events = gpr_atm_acq_load(&g_epoll_set.num_events);
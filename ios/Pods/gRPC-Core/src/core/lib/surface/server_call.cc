@@ -103,6 +103,7 @@ grpc_call_error ValidateServerBatch(const grpc_op* ops, size_t nops) {
 grpc_call_error ServerCall::StartBatch(const grpc_op* ops, size_t nops,
                                        void* notify_tag,
                                        bool is_notify_tag_closure) {
+  GRPC_LATENT_SEE_PARENT_SCOPE("ServerCall::StartBatch");
   if (nops == 0) {
     EndOpImmediately(cq_, notify_tag, is_notify_tag_closure);
     return GRPC_CALL_OK;
@@ -23,6 +23,7 @@
 #include <stdlib.h>
 
 #include <algorithm>
+#include <iterator>
 
 #include "absl/log/check.h"
 #include "absl/log/log.h"
@@ -31,7 +32,7 @@ namespace grpc_core {
 
 BdpEstimator::BdpEstimator(absl::string_view name)
     : accumulator_(0),
-      estimate_(65536),
+      estimate_(kMinEstimate),
       ping_start_time_(gpr_time_0(GPR_CLOCK_MONOTONIC)),
       inter_ping_delay_(Duration::Milliseconds(100)),  // start at 100ms
       stable_estimate_count_(0),
@@ -51,13 +52,34 @@ Timestamp BdpEstimator::CompletePing() {
       << " est=" << estimate_ << " dt=" << dt << " bw=" << bw / 125000.0
       << "Mbs bw_est=" << bw_est_ / 125000.0 << "Mbs";
   CHECK(ping_state_ == PingState::STARTED);
-  if (accumulator_ > 2 * estimate_ / 3 && bw > bw_est_) {
-    estimate_ = std::max(accumulator_, estimate_ * 2);
-    bw_est_ = bw;
+  if (dt > 0) UpdateMinRtt(dt);
+  // A round in which less than half of the estimate arrived was limited by
+  // the application rather than the path, so it may raise the max delivery
+  // rate but must not age a higher sample out of the filter.
+  const bool app_limited = accumulator_ < estimate_ / 2;
+  if (!app_limited || bw > bw_est_) AddBandwidthSample(bw);
+  const int64_t previous_estimate = estimate_;
+  if (min_rtt_ > 0) {
+    estimate_ =
+        std::max(kMinEstimate, static_cast<int64_t>(bw_est_ * min_rtt_));
+  }
+  if (!filled_pipe_) {
+    if (estimate_ >= full_estimate_ + full_estimate_ / 4) {
+      full_estimate_ = estimate_;
+      rounds_without_growth_ = 0;
+    } else if (!app_limited && ++rounds_without_growth_ >= 3) {
+      filled_pipe_ = true;
+      GRPC_TRACE_LOG(bdp_estimator, INFO)
+          << "bdp[" << name_ << "]: pipe filled at " << estimate_;
+    }
+  }
+  if (estimate_ > previous_estimate) {
     GRPC_TRACE_LOG(bdp_estimator, INFO)
         << "bdp[" << name_ << "]: estimate increased to " << estimate_;
-    inter_ping_delay_ /= 2;  // if the ping estimate changes,
-                             // exponentially get faster at probing
+    // While still searching for the pipe size, exponentially get faster at
+    // probing. Once it is found, growth is just noise in the bandwidth
+    // samples and not worth extra pings.
+    if (!filled_pipe_) inter_ping_delay_ /= 2;
   } else if (inter_ping_delay_ < Duration::Seconds(10)) {
     stable_estimate_count_++;
     if (stable_estimate_count_ >= 2) {
@@ -77,4 +99,18 @@ Timestamp BdpEstimator::CompletePing() {
   return Timestamp::Now() + inter_ping_delay_;
 }
 
+void BdpEstimator::AddBandwidthSample(double bw) {
+  bw_samples_[next_bw_sample_] = bw;
+  next_bw_sample_ = (next_bw_sample_ + 1) % kBandwidthWindow;
+  bw_est_ = *std::max_element(std::begin(bw_samples_), std::end(bw_samples_));
+}
+
+void BdpEstimator::UpdateMinRtt(double rtt) {
+  Timestamp now = Timestamp::Now();
+  if (min_rtt_ == 0 || rtt <= min_rtt_ || now - min_rtt_time_ > kMinRttWindow) {
+    min_rtt_ = rtt;
+    min_rtt_time_ = now;
+  }
+}
+
 }  // namespace grpc_core
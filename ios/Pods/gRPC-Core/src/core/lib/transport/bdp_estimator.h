@@ -33,6 +33,11 @@
 
 namespace grpc_core {
 
+// Estimates the bandwidth-delay product of a connection from BDP pings, in the
+// spirit of BBR: each ping round trip yields an RTT sample and a delivery rate
+// sample (the DATA bytes that arrived while the ping was outstanding, over the
+// RTT). The estimate is the windowed max delivery rate times the windowed min
+// RTT, so that neither a short burst nor a single queued ping moves it much.
 class BdpEstimator {
  public:
   explicit BdpEstimator(absl::string_view name);
@@ -40,6 +45,14 @@ class BdpEstimator {
 
   int64_t EstimateBdp() const { return estimate_; }
   double EstimateBandwidth() const { return bw_est_; }
+  // Smallest ping round trip seen recently, or Duration::Infinity() before the
+  // first ping completes.
+  Duration MinRtt() const {
+    return min_rtt_ > 0 ? Duration::FromSecondsAsDouble(min_rtt_)
+                        : Duration::Infinity();
+  }
+  // MinRtt() at full precision, or 0 before the first ping completes.
+  double MinRttSeconds() const { return min_rtt_; }
 
   void AddIncomingBytes(int64_t num_bytes) { accumulator_ += num_bytes; }
 
@@ -75,6 +88,16 @@ class BdpEstimator {
  private:
   enum class PingState { UNSCHEDULED, SCHEDULED, STARTED };
 
+  // The estimate never drops below the default HTTP/2 window.
+  static constexpr int64_t kMinEstimate = 65536;
+  // Number of delivery rate samples the max filter spans.
+  static constexpr size_t kBandwidthWindow = 10;
+  // How long an RTT sample stays eligible as the minimum.
+  static constexpr Duration kMinRttWindow = Duration::Seconds(10);
+
+  void AddBandwidthSample(double bw);
+  void UpdateMinRtt(double rtt);
+
   int64_t accumulator_;
   int64_t estimate_;
   // when was the current ping started?
@@ -82,7 +105,19 @@ class BdpEstimator {
   Duration inter_ping_delay_;
   int stable_estimate_count_;
   PingState ping_state_;
+  // Windowed max of the delivery rate samples, in bytes per second.
   double bw_est_;
+  double bw_samples_[kBandwidthWindow] = {};
+  size_t next_bw_sample_ = 0;
+  // In seconds, 0 until the first ping completes; loopback and LAN round trips
+  // are well below the millisecond resolution of Duration.
+  double min_rtt_ = 0;
+  Timestamp min_rtt_time_ = Timestamp::InfPast();
+  // Startup ends once the estimate fails to grow by a quarter for a few rounds.
+  // After that, growth in the estimate no longer speeds up probing.
+  bool filled_pipe_ = false;
+  int64_t full_estimate_ = 0;
+  int rounds_without_growth_ = 0;
   absl::string_view name_;
 };
 
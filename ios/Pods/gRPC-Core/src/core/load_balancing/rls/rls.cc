@@ -432,7 +432,10 @@ class RlsLb final : public LoadBalancingPolicy {
     RefCountedPtr<ChildPolicyWrapper> default_child_policy_;
   };
 
-  // An LRU cache with adjustable size.
+  // A cache with adjustable size and approximate LRU eviction. Eviction uses
+  // the CLOCK algorithm: a hit only sets the entry's referenced bit, instead
+  // of relinking it in a list on every pick, and the eviction hand gives
+  // referenced entries a second chance.
   class Cache final {
    public:
     using Iterator = std::list<RequestKey>::iterator;
@@ -506,8 +509,16 @@ class RlsLb final : public LoadBalancingPolicy {
           OrphanablePtr<ChildPolicyHandler>* child_policy_to_delete)
           ABSL_EXCLUSIVE_LOCKS_REQUIRED(&RlsLb::mu_);
 
-      // Moves entry to the end of the LRU list.
-      void MarkUsed() ABSL_EXCLUSIVE_LOCKS_REQUIRED(&RlsLb::mu_);
+      // Sets the entry's referenced bit, sparing it from the next pass of
+      // the eviction hand.
+      void MarkUsed() ABSL_EXCLUSIVE_LOCKS_REQUIRED(&RlsLb::mu_) {
+        referenced_ = true;
+      }
+
+      // Clears the referenced bit, returning its previous value.
+      bool TakeReferenced() ABSL_EXCLUSIVE_LOCKS_REQUIRED(&RlsLb::mu_) {
+        return std::exchange(referenced_, false);
+      }
 
       // Takes entries from child_policy_wrappers_ and appends them to the end
       // of \a child_policy_wrappers.
@@ -562,22 +573,22 @@ class RlsLb final : public LoadBalancingPolicy {
       Timestamp stale_time_ ABSL_GUARDED_BY(&RlsLb::mu_) = Timestamp::InfPast();
 
       Timestamp min_expiration_time_ ABSL_GUARDED_BY(&RlsLb::mu_);
-      Cache::Iterator lru_iterator_ ABSL_GUARDED_BY(&RlsLb::mu_);
+      Cache::Iterator clock_iterator_ ABSL_GUARDED_BY(&RlsLb::mu_);
+      bool referenced_ ABSL_GUARDED_BY(&RlsLb::mu_) = false;
     };
 
     explicit Cache(RlsLb* lb_policy);
 
     // Finds an entry from the cache that corresponds to a key. If an entry is
-    // not found, nullptr is returned. Otherwise, the entry is considered
-    // recently used and its order in the LRU list of the cache is updated.
+    // not found, nullptr is returned. Otherwise, the entry is marked as
+    // recently used.
     Entry* Find(const RequestKey& key)
         ABSL_EXCLUSIVE_LOCKS_REQUIRED(&RlsLb::mu_);
 
     // Finds an entry from the cache that corresponds to a key. If an entry is
     // not found, an entry is created, inserted in the cache, and returned to
     // the caller. Otherwise, the entry found is returned to the caller. The
-    // entry returned to the user is considered recently used and its order in
-    // the LRU list of the cache is updated.
+    // entry returned to the user is marked as recently used.
     Entry* FindOrInsert(const RequestKey& key,
                         std::vector<RefCountedPtr<ChildPolicyWrapper>>*
                             child_policy_wrappers_to_delete)
@@ -621,7 +632,10 @@ class RlsLb final : public LoadBalancingPolicy {
     size_t size_limit_ ABSL_GUARDED_BY(&RlsLb::mu_) = 0;
     size_t size_ ABSL_GUARDED_BY(&RlsLb::mu_) = 0;
 
-    std::list<RequestKey> lru_list_ ABSL_GUARDED_BY(&RlsLb::mu_);
+    // Keys in clock order. New entries go just behind the hand, so that they
+    // are the last to be considered for eviction.
+    std::list<RequestKey> clock_list_ ABSL_GUARDED_BY(&RlsLb::mu_);
+    Iterator clock_hand_ ABSL_GUARDED_BY(&RlsLb::mu_) = clock_list_.end();
     std::unordered_map<RequestKey, OrphanablePtr<Entry>, absl::Hash<RequestKey>>
         map_ ABSL_GUARDED_BY(&RlsLb::mu_);
     absl::optional<EventEngine::TaskHandle> cleanup_timer_handle_;
@@ -1158,7 +1172,7 @@ void RlsLb::Cache::Entry::BackoffTimer::Orphan() {
         << "[rlslb " << entry_->lb_policy_.get()
         << "] cache entry=" << entry_.get() << " "
         << (entry_->is_shutdown_ ? "(shut down)"
-                                 : entry_->lru_iterator_->ToString())
+                                 : entry_->clock_iterator_->ToString())
         << ", backoff timer canceled";
   }
   backoff_timer_task_handle_.reset();
@@ -1172,7 +1186,7 @@ void RlsLb::Cache::Entry::BackoffTimer::OnBackoffTimerLocked() {
         << "[rlslb " << entry_->lb_policy_.get()
         << "] cache entry=" << entry_.get() << " "
         << (entry_->is_shutdown_ ? "(shut down)"
-                                 : entry_->lru_iterator_->ToString())
+                                 : entry_->clock_iterator_->ToString())
         << ", backoff timer fired";
     // Skip the update if Orphaned
     if (!backoff_timer_task_handle_.has_value()) return;
@@ -1203,17 +1217,19 @@ RlsLb::Cache::Entry::Entry(RefCountedPtr<RlsLb> lb_policy,
       lb_policy_(std::move(lb_policy)),
       backoff_state_(MakeCacheEntryBackoff()),
       min_expiration_time_(Timestamp::Now() + kMinExpirationTime),
-      lru_iterator_(lb_policy_->cache_.lru_list_.insert(
-          lb_policy_->cache_.lru_list_.end(), key)) {}
+      clock_iterator_(lb_policy_->cache_.clock_list_.insert(
+          lb_policy_->cache_.clock_hand_, key)) {}
 
 void RlsLb::Cache::Entry::Orphan() {
   // We should be holding RlsLB::mu_.
   GRPC_TRACE_LOG(rls_lb, INFO)
       << "[rlslb " << lb_policy_.get() << "] cache entry=" << this << " "
-      << lru_iterator_->ToString() << ": cache entry evicted";
+      << clock_iterator_->ToString() << ": cache entry evicted";
   is_shutdown_ = true;
-  lb_policy_->cache_.lru_list_.erase(lru_iterator_);
-  lru_iterator_ = lb_policy_->cache_.lru_list_.end();  // Just in case.
+  Cache& cache = lb_policy_->cache_;
+  if (cache.clock_hand_ == clock_iterator_) ++cache.clock_hand_;
+  cache.clock_list_.erase(clock_iterator_);
+  clock_iterator_ = cache.clock_list_.end();  // Just in case.
   CHECK(child_policy_wrappers_.empty());
   backoff_state_.reset();
   if (backoff_timer_ != nullptr) {
@@ -1224,9 +1240,9 @@ void RlsLb::Cache::Entry::Orphan() {
 }
 
 size_t RlsLb::Cache::Entry::Size() const {
-  // lru_iterator_ is not valid once we're shut down.
+  // clock_iterator_ is not valid once we're shut down.
   CHECK(!is_shutdown_);
-  return lb_policy_->cache_.EntrySizeForKey(*lru_iterator_);
+  return lb_policy_->cache_.EntrySizeForKey(*clock_iterator_);
 }
 
 LoadBalancingPolicy::PickResult RlsLb::Cache::Entry::Pick(PickArgs args) {
@@ -1240,7 +1256,7 @@ LoadBalancingPolicy::PickResult RlsLb::Cache::Entry::Pick(PickArgs args) {
         i < child_policy_wrappers_.size() - 1) {
       GRPC_TRACE_LOG(rls_lb, INFO)
           << "[rlslb " << lb_policy_.get() << "] cache entry=" << this << " "
-          << lru_iterator_->ToString() << ": target "
+          << clock_iterator_->ToString() << ": target "
           << child_policy_wrapper->target() << " (" << i << " of "
           << child_policy_wrappers_.size()
           << ") in state TRANSIENT_FAILURE; skipping";
@@ -1252,7 +1268,7 @@ LoadBalancingPolicy::PickResult RlsLb::Cache::Entry::Pick(PickArgs args) {
   // the list, so delegate.
   GRPC_TRACE_LOG(rls_lb, INFO)
       << "[rlslb " << lb_policy_.get() << "] cache entry=" << this << " "
-      << lru_iterator_->ToString() << ": target "
+      << clock_iterator_->ToString() << ": target "
       << child_policy_wrapper->target() << " (" << i << " of "
       << child_policy_wrappers_.size() << ") in state "
       << ConnectivityStateName(child_policy_wrapper->connectivity_state())
@@ -1286,18 +1302,11 @@ bool RlsLb::Cache::Entry::CanEvict() const {
   return min_expiration_time_ < now;
 }
 
-void RlsLb::Cache::Entry::MarkUsed() {
-  auto& lru_list = lb_policy_->cache_.lru_list_;
-  auto new_it = lru_list.insert(lru_list.end(), *lru_iterator_);
-  lru_list.erase(lru_iterator_);
-  lru_iterator_ = new_it;
-}
-
 std::vector<RlsLb::ChildPolicyWrapper*>
 RlsLb::Cache::Entry::OnRlsResponseLocked(
     ResponseInfo response, std::unique_ptr<BackOff> backoff_state,
     OrphanablePtr<ChildPolicyHandler>* child_policy_to_delete) {
-  // Move the entry to the end of the LRU list.
+  // Mark the entry as recently used.
   MarkUsed();
   // If the request failed, store the failed status and update the
   // backoff state.
@@ -1444,7 +1453,8 @@ std::vector<RefCountedPtr<RlsLb::ChildPolicyWrapper>> RlsLb::Cache::Shutdown() {
     entry.second->TakeChildPolicyWrappers(&child_policy_wrappers_to_delete);
   }
   map_.clear();
-  lru_list_.clear();
+  clock_list_.clear();
+  clock_hand_ = clock_list_.end();
   if (cleanup_timer_handle_.has_value() &&
       lb_policy_->channel_control_helper()->GetEventEngine()->Cancel(
           *cleanup_timer_handle_)) {
@@ -1506,7 +1516,7 @@ void RlsLb::Cache::OnCleanupTimer() {
 }
 
 size_t RlsLb::Cache::EntrySizeForKey(const RequestKey& key) {
-  // Key is stored twice, once in LRU list and again in the cache map.
+  // Key is stored twice, once in the clock list and again in the cache map.
   return (key.Size() * 2) + sizeof(Entry);
 }
 
@@ -1514,21 +1524,28 @@ void RlsLb::Cache::MaybeShrinkSize(
     size_t bytes, std::vector<RefCountedPtr<ChildPolicyWrapper>>*
                       child_policy_wrappers_to_delete) {
   while (size_ > bytes) {
-    auto lru_it = lru_list_.begin();
-    if (GPR_UNLIKELY(lru_it == lru_list_.end())) break;
-    auto map_it = map_.find(*lru_it);
+    if (GPR_UNLIKELY(clock_list_.empty())) break;
+    if (clock_hand_ == clock_list_.end()) clock_hand_ = clock_list_.begin();
+    auto map_it = map_.find(*clock_hand_);
     CHECK(map_it != map_.end());
+    // Referenced entries get a second chance. Each bit is cleared as the hand
+    // passes, so this finds a victim within two sweeps.
+    if (map_it->second->TakeReferenced()) {
+      ++clock_hand_;
+      continue;
+    }
     if (!map_it->second->CanEvict()) break;
     GRPC_TRACE_LOG(rls_lb, INFO)
-        << "[rlslb " << lb_policy_ << "] LRU eviction: removing entry "
-        << map_it->second.get() << " " << lru_it->ToString();
+        << "[rlslb " << lb_policy_ << "] CLOCK eviction: removing entry "
+        << map_it->second.get() << " " << clock_hand_->ToString();
     size_ -= map_it->second->Size();
     map_it->second->TakeChildPolicyWrappers(child_policy_wrappers_to_delete);
+    // Orphaning the entry advances the hand past it.
     map_.erase(map_it);
   }
   GRPC_TRACE_LOG(rls_lb, INFO)
       << "[rlslb " << lb_policy_
-      << "] LRU pass complete: desired size=" << bytes << " size=" << size_;
+      << "] CLOCK pass complete: desired size=" << bytes << " size=" << size_;
 }
 
 //
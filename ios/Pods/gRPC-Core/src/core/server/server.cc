@@ -33,7 +33,7 @@
 #include <list>
 #include <memory>
 #include <new>
-#include <queue>
+#include <thread>
 #include <type_traits>
 #include <utility>
 #include <vector>
@@ -285,36 +285,42 @@ struct Server::RequestedCall {
 // The RealRequestMatcher is an implementation of RequestMatcherInterface that
 // actually uses all the features of RequestMatcherInterface: expecting the
 // application to explicitly request RPCs and then matching those to incoming
-// RPCs, along with a slow path by which incoming RPCs are put on a locked
-// pending list if they aren't able to be matched to an application request.
+// RPCs, along with a slow path by which incoming RPCs are put on a pending
+// queue if they aren't able to be matched to an application request.
+//
+// Matching takes no server-wide lock. balance_ counts queued requests minus
+// queued incoming calls, so it is positive while requests wait and negative
+// while calls wait. Both sides push onto their own queue *before* moving the
+// counter; whoever moves it across zero is thereby handed one request and one
+// pending call, both guaranteed to be in the queues until shutdown drains
+// them, and performs that match. An incoming call that sees a positive
+// balance claims a request with a compare-exchange and never touches the
+// pending queue at all. Queue nodes can be briefly invisible to a pop while
+// their push is still being linked, so a matcher that was handed a pending
+// call waits for it to show up rather than treating an empty pop as shutdown.
 class Server::RealRequestMatcher : public RequestMatcherInterface {
  public:
   explicit RealRequestMatcher(Server* server)
-      : server_(server), requests_per_cq_(server->cqs_.size()) {}
+      : server_(server), requests_per_cq_(server->cqs_.size()) {
+    MutexLock lock(&server->mu_call_);
+    pending_soft_limit_ = server->pending_backlog_protector_.soft_limit();
+  }
 
   ~RealRequestMatcher() override {
     for (LockedMultiProducerSingleConsumerQueue& queue : requests_per_cq_) {
       CHECK_EQ(queue.Pop(), nullptr);
     }
-    CHECK(pending_filter_stack_.empty());
-    CHECK(pending_promises_.empty());
+    CHECK_EQ(pending_.Pop(), nullptr);
+    CHECK_EQ(front_.load(), nullptr);
   }
 
   void ZombifyPending() override {
-    while (!pending_filter_stack_.empty()) {
-      pending_filter_stack_.front().calld->SetState(
-          CallData::CallState::ZOMBIED);
-      pending_filter_stack_.front().calld->KillZombie();
-      pending_filter_stack_.pop();
-    }
-    while (!pending_promises_.empty()) {
-      pending_promises_.front()->Finish(absl::InternalError("Server closed"));
-      pending_promises_.pop();
-    }
-    zombified_ = true;
+    zombified_.store(true);
+    DrainPending();
   }
 
   void KillRequests(grpc_error_handle error) override {
+    requests_killed_.store(true, std::memory_order_release);
     for (size_t i = 0; i < requests_per_cq_.size(); i++) {
       RequestedCall* rc;
       while ((rc = reinterpret_cast<RequestedCall*>(
@@ -330,173 +336,75 @@ class Server::RealRequestMatcher : public RequestMatcherInterface {
 
   void RequestCallWithPossiblePublish(size_t request_queue_index,
                                       RequestedCall* call) override {
-    if (requests_per_cq_[request_queue_index].Push(&call->mpscq_node)) {
-      // this was the first queued request: we need to lock and start
-      // matching calls
-      struct NextPendingCall {
-        RequestedCall* rc = nullptr;
-        CallData* pending_filter_stack = nullptr;
-        PendingCallPromises pending_promise;
-      };
-      while (true) {
-        NextPendingCall pending_call;
-        {
-          MutexLock lock(&server_->mu_call_);
-          while (!pending_filter_stack_.empty() &&
-                 pending_filter_stack_.front().Age() >
-                     server_->max_time_in_pending_queue_) {
-            pending_filter_stack_.front().calld->SetState(
-                CallData::CallState::ZOMBIED);
-            pending_filter_stack_.front().calld->KillZombie();
-            pending_filter_stack_.pop();
-          }
-          if (!pending_promises_.empty()) {
-            pending_call.rc = reinterpret_cast<RequestedCall*>(
-                requests_per_cq_[request_queue_index].Pop());
-            if (pending_call.rc != nullptr) {
-              pending_call.pending_promise =
-                  std::move(pending_promises_.front());
-              pending_promises_.pop();
-            }
-          } else if (!pending_filter_stack_.empty()) {
-            pending_call.rc = reinterpret_cast<RequestedCall*>(
-                requests_per_cq_[request_queue_index].Pop());
-            if (pending_call.rc != nullptr) {
-              pending_call.pending_filter_stack =
-                  pending_filter_stack_.front().calld;
-              pending_filter_stack_.pop();
-            }
-          }
-        }
-        if (pending_call.rc == nullptr) break;
-        if (pending_call.pending_filter_stack != nullptr) {
-          if (!pending_call.pending_filter_stack->MaybeActivate()) {
-            // Zombied Call
-            pending_call.pending_filter_stack->KillZombie();
-            requests_per_cq_[request_queue_index].Push(
-                &pending_call.rc->mpscq_node);
-          } else {
-            pending_call.pending_filter_stack->Publish(request_queue_index,
-                                                       pending_call.rc);
-          }
-        } else {
-          if (!pending_call.pending_promise->Finish(
-                  server(), request_queue_index, pending_call.rc)) {
-            requests_per_cq_[request_queue_index].Push(
-                &pending_call.rc->mpscq_node);
-          }
-        }
-      }
+    SweepExpiredPending(request_queue_index);
+    requests_per_cq_[request_queue_index].Push(&call->mpscq_node);
+    if (balance_.fetch_add(1, std::memory_order_acq_rel) < 0) {
+      // A call was already waiting: this request is ours to match with it.
+      MatchPending(request_queue_index);
     }
   }
 
   void MatchOrQueue(size_t start_request_queue_index,
                     CallData* calld) override {
-    for (size_t i = 0; i < requests_per_cq_.size(); i++) {
-      size_t cq_idx = (start_request_queue_index + i) % requests_per_cq_.size();
-      RequestedCall* rc =
-          reinterpret_cast<RequestedCall*>(requests_per_cq_[cq_idx].TryPop());
-      if (rc != nullptr) {
-        calld->SetState(CallData::CallState::ACTIVATED);
-        calld->Publish(cq_idx, rc);
-        return;
-      }
-    }
-    // No cq to take the request found; queue it on the slow list.
-    // We need to ensure that all the queues are empty.  We do this under
-    // the server mu_call_ lock to ensure that if something is added to
-    // an empty request queue, it will block until the call is actually
-    // added to the pending list.
-    RequestedCall* rc = nullptr;
-    size_t cq_idx = 0;
-    size_t loop_count;
-    {
-      MutexLock lock(&server_->mu_call_);
-      for (loop_count = 0; loop_count < requests_per_cq_.size(); loop_count++) {
-        cq_idx =
-            (start_request_queue_index + loop_count) % requests_per_cq_.size();
-        rc = reinterpret_cast<RequestedCall*>(requests_per_cq_[cq_idx].Pop());
-        if (rc != nullptr) {
-          break;
-        }
-      }
+    if (TryClaimRequest()) {
+      size_t cq_idx = 0;
+      RequestedCall* rc = PopRequest(start_request_queue_index, &cq_idx);
       if (rc == nullptr) {
-        calld->SetState(CallData::CallState::PENDING);
-        pending_filter_stack_.push(PendingCallFilterStack{calld});
+        // Shutdown failed the request we claimed.
+        calld->SetState(CallData::CallState::ZOMBIED);
+        calld->KillZombie();
         return;
       }
+      calld->SetState(CallData::CallState::ACTIVATED);
+      calld->Publish(cq_idx, rc);
+      return;
     }
-    calld->SetState(CallData::CallState::ACTIVATED);
-    calld->Publish(cq_idx, rc);
+    // No request available; queue the call on the slow list.
+    calld->SetState(CallData::CallState::PENDING);
+    EnqueuePending(new PendingCall(calld), start_request_queue_index);
   }
 
   ArenaPromise<absl::StatusOr<MatchResult>> MatchRequest(
       size_t start_request_queue_index) override {
-    for (size_t i = 0; i < requests_per_cq_.size(); i++) {
-      size_t cq_idx = (start_request_queue_index + i) % requests_per_cq_.size();
-      RequestedCall* rc =
-          reinterpret_cast<RequestedCall*>(requests_per_cq_[cq_idx].TryPop());
-      if (rc != nullptr) {
-        return Immediate(MatchResult(server(), cq_idx, rc));
+    if (TryClaimRequest()) {
+      size_t cq_idx = 0;
+      RequestedCall* rc = PopRequest(start_request_queue_index, &cq_idx);
+      if (rc == nullptr) {
+        return Immediate(absl::InternalError("Server closed"));
       }
+      return Immediate(MatchResult(server(), cq_idx, rc));
     }
-    // No cq to take the request found; queue it on the slow list.
-    // We need to ensure that all the queues are empty.  We do this under
-    // the server mu_call_ lock to ensure that if something is added to
-    // an empty request queue, it will block until the call is actually
-    // added to the pending list.
-    RequestedCall* rc = nullptr;
-    size_t cq_idx = 0;
-    size_t loop_count;
-    {
-      std::vector<std::shared_ptr<ActivityWaiter>> removed_pending;
+    // Only take mu_call_ (which guards the random source) once the backlog is
+    // long enough that the protector might reject.
+    const intptr_t balance = balance_.load(std::memory_order_relaxed);
+    const uint64_t pending = balance < 0 ? static_cast<uint64_t>(-balance) : 0;
+    if (pending > pending_soft_limit_) {
       MutexLock lock(&server_->mu_call_);
-      while (!pending_promises_.empty() &&
-             pending_promises_.front()->Age() >
-                 server_->max_time_in_pending_queue_) {
-        removed_pending.push_back(std::move(pending_promises_.front()));
-        pending_promises_.pop();
-      }
-      for (loop_count = 0; loop_count < requests_per_cq_.size(); loop_count++) {
-        cq_idx =
-            (start_request_queue_index + loop_count) % requests_per_cq_.size();
-        rc = reinterpret_cast<RequestedCall*>(requests_per_cq_[cq_idx].Pop());
-        if (rc != nullptr) break;
-      }
-      if (rc == nullptr) {
-        if (server_->pending_backlog_protector_.Reject(pending_promises_.size(),
-                                                       server_->bitgen_)) {
-          return Immediate(absl::ResourceExhaustedError(
-              "Too many pending requests for this server"));
-        }
-        if (zombified_) {
-          return Immediate(absl::InternalError("Server closed"));
-        }
-        auto w = std::make_shared<ActivityWaiter>(
-            GetContext<Activity>()->MakeOwningWaker());
-        pending_promises_.push(w);
-        return OnCancel(
-            [w]() -> Poll<absl::StatusOr<MatchResult>> {
-              std::unique_ptr<absl::StatusOr<MatchResult>> r(
-                  w->result.exchange(nullptr, std::memory_order_acq_rel));
-              if (r == nullptr) return Pending{};
-              return std::move(*r);
-            },
-            [w]() { w->Finish(absl::CancelledError()); });
+      if (server_->pending_backlog_protector_.Reject(pending,
+                                                     server_->bitgen_)) {
+        return Immediate(absl::ResourceExhaustedError(
+            "Too many pending requests for this server"));
       }
     }
-    return Immediate(MatchResult(server(), cq_idx, rc));
+    if (zombified_.load(std::memory_order_acquire)) {
+      return Immediate(absl::InternalError("Server closed"));
+    }
+    auto w = std::make_shared<ActivityWaiter>(
+        GetContext<Activity>()->MakeOwningWaker());
+    EnqueuePending(new PendingCall(w), start_request_queue_index);
+    return OnCancel(
+        [w]() -> Poll<absl::StatusOr<MatchResult>> {
+          std::unique_ptr<absl::StatusOr<MatchResult>> r(
+              w->result.exchange(nullptr, std::memory_order_acq_rel));
+          if (r == nullptr) return Pending{};
+          return std::move(*r);
+        },
+        [w]() { w->Finish(absl::CancelledError()); });
   }
 
   Server* server() const final { return server_; }
 
  private:
-  Server* const server_;
-  struct PendingCallFilterStack {
-    CallData* calld;
-    Timestamp created = Timestamp::Now();
-    Duration Age() { return Timestamp::Now() - created; }
-  };
   struct ActivityWaiter {
     using ResultType = absl::StatusOr<MatchResult>;
     explicit ActivityWaiter(Waker waker) : waker(std::move(waker)) {}
@@ -528,16 +436,229 @@ class Server::RealRequestMatcher : public RequestMatcherInterface {
       waker.WakeupAsync();
       return true;
     }
-    Duration Age() { return Timestamp::Now() - created; }
     Waker waker;
     std::atomic<ResultType*> result{nullptr};
-    const Timestamp created = Timestamp::Now();
   };
   using PendingCallPromises = std::shared_ptr<ActivityWaiter>;
-  std::queue<PendingCallFilterStack> pending_filter_stack_;
-  std::queue<PendingCallPromises> pending_promises_;
+
+  // An incoming call waiting for the application to request it: exactly one
+  // of calld and waiter is set. mpscq_node must be the first member so that
+  // queue nodes can be cast back to a PendingCall.
+  struct PendingCall {
+    explicit PendingCall(CallData* calld) : calld(calld) {}
+    explicit PendingCall(PendingCallPromises waiter)
+        : waiter(std::move(waiter)) {}
+    MultiProducerSingleConsumerQueue::Node mpscq_node;
+    CallData* const calld = nullptr;
+    const PendingCallPromises waiter;
+    const Timestamp created = Timestamp::Now();
+    Duration Age() const { return Timestamp::Now() - created; }
+  };
+
+  // Paces a thread waiting for a queue entry that balance_ says is there but
+  // that another thread has yet to push back: spins briefly, then yields,
+  // then sleeps.
+  class QueueWaitBackoff {
+   public:
+    void Wait() {
+      ++rounds_;
+      if (rounds_ <= kSpinRounds) return;
+      if (rounds_ <= kYieldRounds) {
+        std::this_thread::yield();
+        return;
+      }
+      gpr_sleep_until(gpr_time_add(gpr_now(GPR_CLOCK_MONOTONIC),
+                                   gpr_time_from_micros(50, GPR_TIMESPAN)));
+    }
+
+   private:
+    static constexpr int kSpinRounds = 16;
+    static constexpr int kYieldRounds = 64;
+    int rounds_ = 0;
+  };
+
+  // Takes ownership of one queued request if any are unclaimed.
+  bool TryClaimRequest() {
+    intptr_t balance = balance_.load(std::memory_order_relaxed);
+    while (balance > 0) {
+      if (balance_.compare_exchange_weak(balance, balance - 1,
+                                         std::memory_order_acq_rel,
+                                         std::memory_order_relaxed)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // Queues a pending call and counts it in balance_. at_front is only used by
+  // SweepExpiredPending() to put back the oldest call it took out.
+  void EnqueuePending(PendingCall* pending, size_t start_request_queue_index,
+                      bool at_front = false) {
+    if (at_front) {
+      CHECK_EQ(front_.exchange(pending, std::memory_order_acq_rel), nullptr);
+    } else {
+      pending_.Push(&pending->mpscq_node);
+    }
+    if (balance_.fetch_sub(1) > 0) {
+      // A request was queued after TryClaimRequest() looked: it's ours.
+      MatchPending(start_request_queue_index);
+    } else if (zombified_.load()) {
+      // Raced with ZombifyPending(): don't leave the call behind.
+      DrainPending();
+    }
+  }
+
+  // Called when balance_ hands the caller one queued request and one pending
+  // call; pairs them up, retrying if the pending call has gone away.
+  void MatchPending(size_t start_request_queue_index) {
+    while (true) {
+      PendingCall* pending = PopPending();
+      size_t cq_idx = 0;
+      RequestedCall* rc = PopRequest(start_request_queue_index, &cq_idx);
+      if (pending == nullptr || rc == nullptr) {
+        // Shutdown drained one side from under us.
+        if (pending != nullptr) KillPending(pending);
+        if (rc != nullptr) {
+          server_->FailCall(cq_idx, rc, GRPC_ERROR_CREATE("Server Shutdown"));
+        }
+        return;
+      }
+      if (Publish(pending, cq_idx, rc)) return;
+      // Hand the request back; if another call is already waiting for it,
+      // we own that match too.
+      requests_per_cq_[cq_idx].Push(&rc->mpscq_node);
+      if (balance_.fetch_add(1, std::memory_order_acq_rel) >= 0) return;
+      start_request_queue_index = cq_idx;
+    }
+  }
+
+  // Pops a pending call the caller owns through balance_. Returns nullptr
+  // only once ZombifyPending() has drained the queue.
+  PendingCall* PopPending() {
+    QueueWaitBackoff backoff;
+    while (true) {
+      const bool zombified = zombified_.load(std::memory_order_acquire);
+      PendingCall* pending =
+          front_.exchange(nullptr, std::memory_order_acq_rel);
+      if (pending != nullptr) return pending;
+      pending = reinterpret_cast<PendingCall*>(pending_.Pop());
+      if (pending != nullptr) return pending;
+      if (zombified) return nullptr;
+      backoff.Wait();
+    }
+  }
+
+  bool Expired(const PendingCall& pending) const {
+    return pending.calld != nullptr &&
+           pending.Age() > server_->max_time_in_pending_queue_;
+  }
+
+  // Kills filter-stack calls that have waited longer than
+  // max_time_in_pending_queue_, oldest first. Each one is claimed through
+  // balance_ like a match would; the first call that is still live goes back
+  // to the front of the queue. Only one thread sweeps at a time, and it keeps
+  // sweeping_ until that call is back, so front_ holds at most one call.
+  void SweepExpiredPending(size_t request_queue_index) {
+    if (sweeping_.exchange(true, std::memory_order_acquire)) return;
+    while (true) {
+      intptr_t balance = balance_.load(std::memory_order_relaxed);
+      bool claimed = false;
+      while (balance < 0 && !claimed) {
+        claimed = balance_.compare_exchange_weak(balance, balance + 1,
+                                                 std::memory_order_acq_rel,
+                                                 std::memory_order_relaxed);
+      }
+      if (!claimed) break;
+      PendingCall* pending = PopPending();
+      if (pending == nullptr) break;
+      if (!Expired(*pending)) {
+        EnqueuePending(pending, request_queue_index, /*at_front=*/true);
+        break;
+      }
+      KillPending(pending);
+    }
+    sweeping_.store(false, std::memory_order_release);
+  }
+
+  // Gives rc to the pending call. Returns false, leaving rc with the caller,
+  // if the call expired or was cancelled while it waited.
+  bool Publish(PendingCall* pending, size_t cq_idx, RequestedCall* rc) {
+    std::unique_ptr<PendingCall> owned(pending);
+    if (pending->calld == nullptr) {
+      return pending->waiter->Finish(server(), cq_idx, rc);
+    }
+    if (Expired(*pending)) {
+      pending->calld->SetState(CallData::CallState::ZOMBIED);
+      pending->calld->KillZombie();
+      return false;
+    }
+    if (!pending->calld->MaybeActivate()) {
+      // Zombied Call
+      pending->calld->KillZombie();
+      return false;
+    }
+    pending->calld->Publish(cq_idx, rc);
+    return true;
+  }
+
+  void KillPending(PendingCall* pending) {
+    std::unique_ptr<PendingCall> owned(pending);
+    if (pending->calld != nullptr) {
+      pending->calld->SetState(CallData::CallState::ZOMBIED);
+      pending->calld->KillZombie();
+    } else {
+      pending->waiter->Finish(absl::InternalError("Server closed"));
+    }
+  }
+
+  void DrainPending() {
+    PendingCall* front = front_.exchange(nullptr, std::memory_order_acq_rel);
+    if (front != nullptr) KillPending(front);
+    MultiProducerSingleConsumerQueue::Node* node;
+    while ((node = pending_.Pop()) != nullptr) {
+      KillPending(reinterpret_cast<PendingCall*>(node));
+    }
+  }
+
+  // Pops a request the caller owns through balance_, preferring the queue at
+  // start_request_queue_index and stealing from the other cqs otherwise.
+  // Returns nullptr only once KillRequests() has emptied the queues.
+  RequestedCall* PopRequest(size_t start_request_queue_index, size_t* cq_idx) {
+    const size_t n = requests_per_cq_.size();
+    for (size_t i = 0; i < n; i++) {
+      *cq_idx = (start_request_queue_index + i) % n;
+      RequestedCall* rc =
+          reinterpret_cast<RequestedCall*>(requests_per_cq_[*cq_idx].TryPop());
+      if (rc != nullptr) return rc;
+    }
+    QueueWaitBackoff backoff;
+    while (true) {
+      const bool killed = requests_killed_.load(std::memory_order_acquire);
+      for (size_t i = 0; i < n; i++) {
+        *cq_idx = (start_request_queue_index + i) % n;
+        RequestedCall* rc =
+            reinterpret_cast<RequestedCall*>(requests_per_cq_[*cq_idx].Pop());
+        if (rc != nullptr) return rc;
+      }
+      if (killed) return nullptr;
+      backoff.Wait();
+    }
+  }
+
+  Server* const server_;
   std::vector<LockedMultiProducerSingleConsumerQueue> requests_per_cq_;
-  bool zombified_ = false;
+  LockedMultiProducerSingleConsumerQueue pending_;
+  // The oldest pending call, when SweepExpiredPending() had to put it back.
+  // Popped before pending_.
+  std::atomic<PendingCall*> front_{nullptr};
+  std::atomic<bool> sweeping_{false};
+  // Queued requests minus pending calls; see the class comment.
+  std::atomic<intptr_t> balance_{0};
+  std::atomic<bool> zombified_{false};
+  std::atomic<bool> requests_killed_{false};
+  // Cached from the backlog protector so that MatchRequest() can skip
+  // mu_call_ while the backlog is short.
+  uint64_t pending_soft_limit_;
 };
 
 // AllocatingRequestMatchers don't allow the application to request an RPC in
@@ -84,6 +84,27 @@
   #include <openssl/x509v3.h>
 #endif
 
+// Kernel TLS offload needs BoringSSL for HKDF_expand and the key block and
+// sequence number accessors, and a kernel with TLS 1.3 support in
+// <linux/tls.h>.
+#if defined(GPR_LINUX) && defined(OPENSSL_IS_BORINGSSL)
+#include <errno.h>
+#include <linux/tls.h>
+#include <netinet/tcp.h>
+#if COCOAPODS==1
+  #include <openssl_grpc/hkdf.h>
+#else
+  #include <openssl/hkdf.h>
+#endif
+#if defined(TCP_ULP) && defined(TLS_TX) && defined(TLS_1_3_VERSION)
+#define GRPC_SSL_HAVE_KERNEL_TLS 1
+#ifndef SOL_TLS
+#define SOL_TLS 282
+#endif
+#endif
+#endif
+
+#include <algorithm>
 #include <memory>
 #include <string>
 
@@ -98,7 +119,9 @@
 #include "src/core/tsi/ssl_transport_security_utils.h"
 #include "src/core/tsi/ssl_types.h"
 #include "src/core/tsi/transport_security.h"
+#include "src/core/tsi/transport_security_grpc.h"
 #include "src/core/util/crash.h"
+#include "src/core/util/strerror.h"
 #include "src/core/util/useful.h"
 
 // --- Constants. ---
@@ -179,6 +202,26 @@ struct tsi_ssl_frame_protector {
   size_t buffer_size;
   size_t buffer_offset;
 };
+struct tsi_ssl_zero_copy_grpc_protector {
+  tsi_zero_copy_grpc_protector base;
+  SSL* ssl;
+  BIO* network_io;
+  size_t max_frame_size;
+  // Plaintext shorter than a full record, gathered from small slices so that
+  // they share a record instead of each being sealed on its own.
+  unsigned char* buffer;
+  size_t buffer_size;
+  size_t buffer_offset;
+  // Position in the TLS record currently being received: the header bytes
+  // seen so far, or the body bytes still to come once the header is complete.
+  unsigned char record_header[5];
+  size_t record_header_size;
+  size_t record_body_remaining;
+  // Plaintext is read into the unused tail of this slice and handed out as
+  // exact-size sub-slices, so small records share one allocation.
+  grpc_slice read_staging;
+  size_t read_staging_offset;
+};
 // --- Library Initialization. ---
 
 static gpr_once g_init_openssl_once = GPR_ONCE_INIT;
@@ -1376,6 +1419,235 @@ static const tsi_frame_protector_vtable frame_protector_vtable = {
     ssl_protector_destroy,
 };
 
+// --- tsi_zero_copy_grpc_protector methods implementation. ---
+
+// Moves all the TLS records that SSL has written to |network_io| into a new
+// slice at the end of |protected_slices|.
+static tsi_result ssl_zero_copy_grpc_protector_drain(
+    tsi_ssl_zero_copy_grpc_protector* impl,
+    grpc_slice_buffer* protected_slices) {
+  size_t pending = BIO_ctrl_pending(impl->network_io);
+  if (pending == 0) return TSI_OK;
+  CHECK_LE(pending, static_cast<size_t>(INT_MAX));
+  grpc_slice slice = GRPC_SLICE_MALLOC(pending);
+  int read_from_ssl = BIO_read(impl->network_io, GRPC_SLICE_START_PTR(slice),
+                               static_cast<int>(pending));
+  if (read_from_ssl < 0 || static_cast<size_t>(read_from_ssl) != pending) {
+    LOG(ERROR) << "Could not read from BIO even though some data is pending";
+    grpc_slice_unref(slice);
+    return TSI_INTERNAL_ERROR;
+  }
+  grpc_slice_buffer_add(protected_slices, slice);
+  return TSI_OK;
+}
+
+// Seals |size| bytes of plaintext into one or more TLS records, appended to
+// |protected_slices|.
+static tsi_result ssl_zero_copy_grpc_protector_seal(
+    tsi_ssl_zero_copy_grpc_protector* impl, const unsigned char* bytes,
+    size_t size, grpc_slice_buffer* protected_slices) {
+  while (size > 0) {
+    size_t chunk_size = std::min(size, impl->buffer_size);
+    tsi_result result =
+        grpc_core::DoSslWrite(impl->ssl, const_cast<unsigned char*>(bytes),
+                              chunk_size);
+    if (result != TSI_OK) return result;
+    // Drain after every record, since the BIO pair only holds a few of them.
+    result = ssl_zero_copy_grpc_protector_drain(impl, protected_slices);
+    if (result != TSI_OK) return result;
+    bytes += chunk_size;
+    size -= chunk_size;
+  }
+  return TSI_OK;
+}
+
+static tsi_result ssl_zero_copy_grpc_protector_protect(
+    tsi_zero_copy_grpc_protector* self, grpc_slice_buffer* unprotected_slices,
+    grpc_slice_buffer* protected_slices) {
+  if (self == nullptr || unprotected_slices == nullptr ||
+      protected_slices == nullptr) {
+    LOG(ERROR) << "Invalid nullptr arguments to zero-copy ssl protect.";
+    return TSI_INVALID_ARGUMENT;
+  }
+  tsi_ssl_zero_copy_grpc_protector* impl =
+      reinterpret_cast<tsi_ssl_zero_copy_grpc_protector*>(self);
+  tsi_result result = TSI_OK;
+  for (size_t i = 0; i < unprotected_slices->count && result == TSI_OK; ++i) {
+    const unsigned char* bytes =
+        GRPC_SLICE_START_PTR(unprotected_slices->slices[i]);
+    size_t size = GRPC_SLICE_LENGTH(unprotected_slices->slices[i]);
+    // Top up a partially gathered record first.
+    if (impl->buffer_offset > 0) {
+      size_t to_copy = std::min(size, impl->buffer_size - impl->buffer_offset);
+      memcpy(impl->buffer + impl->buffer_offset, bytes, to_copy);
+      impl->buffer_offset += to_copy;
+      bytes += to_copy;
+      size -= to_copy;
+      if (impl->buffer_offset < impl->buffer_size) continue;
+      result = ssl_zero_copy_grpc_protector_seal(impl, impl->buffer,
+                                                 impl->buffer_offset,
+                                                 protected_slices);
+      impl->buffer_offset = 0;
+      if (result != TSI_OK) break;
+    }
+    // Seal full records straight from the slice, and gather the tail.
+    size_t direct_size = size - size % impl->buffer_size;
+    result = ssl_zero_copy_grpc_protector_seal(impl, bytes, direct_size,
+                                               protected_slices);
+    if (result != TSI_OK) break;
+    memcpy(impl->buffer, bytes + direct_size, size - direct_size);
+    impl->buffer_offset = size - direct_size;
+  }
+  // Everything handed to protect is sent now, like the frame protector's
+  // protect_flush.
+  if (result == TSI_OK && impl->buffer_offset > 0) {
+    result = ssl_zero_copy_grpc_protector_seal(
+        impl, impl->buffer, impl->buffer_offset, protected_slices);
+    impl->buffer_offset = 0;
+  }
+  grpc_slice_buffer_reset_and_unref(unprotected_slices);
+  return result;
+}
+
+// Follows the TLS record framing of |size| protected bytes about to be handed
+// to SSL.
+static void ssl_zero_copy_grpc_protector_track_records(
+    tsi_ssl_zero_copy_grpc_protector* impl, const unsigned char* bytes,
+    size_t size) {
+  while (size > 0) {
+    if (impl->record_body_remaining > 0) {
+      size_t n = std::min(size, impl->record_body_remaining);
+      impl->record_body_remaining -= n;
+      bytes += n;
+      size -= n;
+      continue;
+    }
+    impl->record_header[impl->record_header_size++] = *bytes++;
+    --size;
+    if (impl->record_header_size == sizeof(impl->record_header)) {
+      impl->record_body_remaining =
+          (static_cast<size_t>(impl->record_header[3]) << 8) |
+          impl->record_header[4];
+      impl->record_header_size = 0;
+    }
+  }
+}
+
+// Reads all the plaintext that SSL can produce from the records it has
+// received so far, into new slices at the end of |unprotected_slices|.
+static tsi_result ssl_zero_copy_grpc_protector_read(
+    tsi_ssl_zero_copy_grpc_protector* impl,
+    grpc_slice_buffer* unprotected_slices) {
+  // Below this much room, start a new staging slice rather than split reads
+  // into slivers.
+  const size_t min_read_size = std::min<size_t>(1024, impl->buffer_size);
+  while (true) {
+    size_t available =
+        GRPC_SLICE_LENGTH(impl->read_staging) - impl->read_staging_offset;
+    if (available < min_read_size) {
+      // Slices already handed out keep the old staging memory alive.
+      grpc_slice_unref(impl->read_staging);
+      impl->read_staging = GRPC_SLICE_MALLOC(impl->buffer_size);
+      impl->read_staging_offset = 0;
+      available = impl->buffer_size;
+    }
+    size_t read_size = available;
+    tsi_result result = grpc_core::DoSslRead(
+        impl->ssl,
+        GRPC_SLICE_START_PTR(impl->read_staging) + impl->read_staging_offset,
+        &read_size);
+    if (result != TSI_OK || read_size == 0) return result;
+    grpc_slice_buffer_add(
+        unprotected_slices,
+        grpc_slice_sub(impl->read_staging, impl->read_staging_offset,
+                       impl->read_staging_offset + read_size));
+    impl->read_staging_offset += read_size;
+  }
+}
+
+static tsi_result ssl_zero_copy_grpc_protector_unprotect(
+    tsi_zero_copy_grpc_protector* self, grpc_slice_buffer* protected_slices,
+    grpc_slice_buffer* unprotected_slices, int* min_progress_size) {
+  if (self == nullptr || unprotected_slices == nullptr ||
+      protected_slices == nullptr) {
+    LOG(ERROR) << "Invalid nullptr arguments to zero-copy ssl unprotect.";
+    return TSI_INVALID_ARGUMENT;
+  }
+  tsi_ssl_zero_copy_grpc_protector* impl =
+      reinterpret_cast<tsi_ssl_zero_copy_grpc_protector*>(self);
+  tsi_result result = TSI_OK;
+  for (size_t i = 0; i < protected_slices->count && result == TSI_OK; ++i) {
+    const unsigned char* bytes =
+        GRPC_SLICE_START_PTR(protected_slices->slices[i]);
+    size_t size = GRPC_SLICE_LENGTH(protected_slices->slices[i]);
+    ssl_zero_copy_grpc_protector_track_records(impl, bytes, size);
+    while (size > 0) {
+      // The BIO pair only buffers a few records; read the plaintext out
+      // whenever it fills up.
+      size_t to_write = std::min<size_t>(size, INT_MAX);
+      int written_into_ssl = BIO_write(impl->network_io, bytes,
+                                       static_cast<int>(to_write));
+      if (written_into_ssl < 0 && !BIO_should_retry(impl->network_io)) {
+        LOG(ERROR) << "Sending protected frame to ssl failed with "
+                   << written_into_ssl;
+        result = TSI_INTERNAL_ERROR;
+        break;
+      }
+      if (written_into_ssl > 0) {
+        bytes += written_into_ssl;
+        size -= static_cast<size_t>(written_into_ssl);
+      }
+      size_t unprotected_length = unprotected_slices->length;
+      result = ssl_zero_copy_grpc_protector_read(impl, unprotected_slices);
+      if (result != TSI_OK) break;
+      if (written_into_ssl <= 0 &&
+          unprotected_slices->length == unprotected_length) {
+        LOG(ERROR) << "SSL made no progress on a full BIO.";
+        result = TSI_INTERNAL_ERROR;
+        break;
+      }
+    }
+  }
+  grpc_slice_buffer_reset_and_unref(protected_slices);
+  if (min_progress_size != nullptr) {
+    size_t needed =
+        impl->record_body_remaining > 0
+            ? impl->record_body_remaining
+            : sizeof(impl->record_header) - impl->record_header_size;
+    *min_progress_size = static_cast<int>(std::min<size_t>(needed, INT_MAX));
+  }
+  return result;
+}
+
+static void ssl_zero_copy_grpc_protector_destroy(
+    tsi_zero_copy_grpc_protector* self) {
+  if (self == nullptr) return;
+  tsi_ssl_zero_copy_grpc_protector* impl =
+      reinterpret_cast<tsi_ssl_zero_copy_grpc_protector*>(self);
+  gpr_free(impl->buffer);
+  grpc_slice_unref(impl->read_staging);
+  if (impl->ssl != nullptr) SSL_free(impl->ssl);
+  if (impl->network_io != nullptr) BIO_free(impl->network_io);
+  gpr_free(self);
+}
+
+static tsi_result ssl_zero_copy_grpc_protector_max_frame_size(
+    tsi_zero_copy_grpc_protector* self, size_t* max_frame_size) {
+  if (self == nullptr || max_frame_size == nullptr) return TSI_INVALID_ARGUMENT;
+  tsi_ssl_zero_copy_grpc_protector* impl =
+      reinterpret_cast<tsi_ssl_zero_copy_grpc_protector*>(self);
+  *max_frame_size = impl->max_frame_size;
+  return TSI_OK;
+}
+
+static const tsi_zero_copy_grpc_protector_vtable
+    ssl_zero_copy_grpc_protector_vtable = {
+        ssl_zero_copy_grpc_protector_protect,
+        ssl_zero_copy_grpc_protector_unprotect,
+        ssl_zero_copy_grpc_protector_destroy,
+        ssl_zero_copy_grpc_protector_max_frame_size,
+};
+
 // --- tsi_server_handshaker_factory methods implementation. ---
 
 static void tsi_ssl_handshaker_factory_destroy(
@@ -1528,7 +1800,54 @@ static tsi_result ssl_handshaker_result_extract_peer(
 static tsi_result ssl_handshaker_result_get_frame_protector_type(
     const tsi_handshaker_result* /*self*/,
     tsi_frame_protector_type* frame_protector_type) {
-  *frame_protector_type = TSI_FRAME_PROTECTOR_NORMAL;
+  *frame_protector_type = TSI_FRAME_PROTECTOR_NORMAL_OR_ZERO_COPY;
+  return TSI_OK;
+}
+
+// Clamps the requested protected frame size to what the ssl protectors
+// support, and returns it.
+static size_t ssl_protected_frame_size(
+    size_t* max_output_protected_frame_size) {
+  if (max_output_protected_frame_size == nullptr) {
+    return TSI_SSL_MAX_PROTECTED_FRAME_SIZE_UPPER_BOUND;
+  }
+  if (*max_output_protected_frame_size >
+      TSI_SSL_MAX_PROTECTED_FRAME_SIZE_UPPER_BOUND) {
+    *max_output_protected_frame_size =
+        TSI_SSL_MAX_PROTECTED_FRAME_SIZE_UPPER_BOUND;
+  } else if (*max_output_protected_frame_size <
+             TSI_SSL_MAX_PROTECTED_FRAME_SIZE_LOWER_BOUND) {
+    *max_output_protected_frame_size =
+        TSI_SSL_MAX_PROTECTED_FRAME_SIZE_LOWER_BOUND;
+  }
+  return *max_output_protected_frame_size;
+}
+
+static tsi_result ssl_handshaker_result_create_zero_copy_grpc_protector(
+    const tsi_handshaker_result* self, size_t* max_output_protected_frame_size,
+    tsi_zero_copy_grpc_protector** protector) {
+  tsi_ssl_handshaker_result* impl =
+      reinterpret_cast<tsi_ssl_handshaker_result*>(
+          const_cast<tsi_handshaker_result*>(self));
+  tsi_ssl_zero_copy_grpc_protector* protector_impl =
+      static_cast<tsi_ssl_zero_copy_grpc_protector*>(
+          gpr_zalloc(sizeof(*protector_impl)));
+
+  protector_impl->max_frame_size =
+      ssl_protected_frame_size(max_output_protected_frame_size);
+  protector_impl->buffer_size =
+      protector_impl->max_frame_size - TSI_SSL_MAX_PROTECTION_OVERHEAD;
+  protector_impl->buffer =
+      static_cast<unsigned char*>(gpr_malloc(protector_impl->buffer_size));
+  protector_impl->read_staging = grpc_empty_slice();
+
+  // Transfer ownership of ssl and network_io to the frame protector.
+  protector_impl->ssl = impl->ssl;
+  impl->ssl = nullptr;
+  protector_impl->network_io = impl->network_io;
+  impl->network_io = nullptr;
+  protector_impl->base.vtable = &ssl_zero_copy_grpc_protector_vtable;
+  *protector = &protector_impl->base;
   return TSI_OK;
 }
 
@@ -1536,26 +1855,13 @@ static tsi_result ssl_handshaker_result_create_frame_protector(
     const tsi_handshaker_result* self, size_t* max_output_protected_frame_size,
     tsi_frame_protector** protector) {
   size_t actual_max_output_protected_frame_size =
-      TSI_SSL_MAX_PROTECTED_FRAME_SIZE_UPPER_BOUND;
+      ssl_protected_frame_size(max_output_protected_frame_size);
   tsi_ssl_handshaker_result* impl =
       reinterpret_cast<tsi_ssl_handshaker_result*>(
           const_cast<tsi_handshaker_result*>(self));
   tsi_ssl_frame_protector* protector_impl =
       static_cast<tsi_ssl_frame_protector*>(
           gpr_zalloc(sizeof(*protector_impl)));
-
-  if (max_output_protected_frame_size != nullptr) {
-    if (*max_output_protected_frame_size >
-        TSI_SSL_MAX_PROTECTED_FRAME_SIZE_UPPER_BOUND) {
-      *max_output_protected_frame_size =
-          TSI_SSL_MAX_PROTECTED_FRAME_SIZE_UPPER_BOUND;
-    } else if (*max_output_protected_frame_size <
-               TSI_SSL_MAX_PROTECTED_FRAME_SIZE_LOWER_BOUND) {
-      *max_output_protected_frame_size =
-          TSI_SSL_MAX_PROTECTED_FRAME_SIZE_LOWER_BOUND;
-    }
-    actual_max_output_protected_frame_size = *max_output_protected_frame_size;
-  }
   protector_impl->buffer_size =
       actual_max_output_protected_frame_size - TSI_SSL_MAX_PROTECTION_OVERHEAD;
   protector_impl->buffer =
@@ -1598,7 +1904,7 @@ static void ssl_handshaker_result_destroy(tsi_handshaker_result* self) {
 static const tsi_handshaker_result_vtable handshaker_result_vtable = {
     ssl_handshaker_result_extract_peer,
     ssl_handshaker_result_get_frame_protector_type,
-    nullptr,  // create_zero_copy_grpc_protector
+    ssl_handshaker_result_create_zero_copy_grpc_protector,
     ssl_handshaker_result_create_frame_protector,
     ssl_handshaker_result_get_unused_bytes,
     ssl_handshaker_result_destroy,
@@ -1905,6 +2211,174 @@ static const tsi_handshaker_vtable handshaker_vtable = {
     nullptr,  // shutdown
 };
 
+// --- Kernel TLS offload. ---
+
+#ifdef GRPC_SSL_HAVE_KERNEL_TLS
+
+union tsi_ssl_kernel_tls_crypto_info {
+  tls12_crypto_info_aes_gcm_128 aes_gcm_128;
+  tls12_crypto_info_aes_gcm_256 aes_gcm_256;
+};
+
+// HKDF-Expand-Label from RFC 8446 section 7.1, with an empty context.
+static bool ssl_hkdf_expand_label(const EVP_MD* digest,
+                                  bssl::Span<const uint8_t> secret,
+                                  absl::string_view label, unsigned char* out,
+                                  size_t out_size) {
+  static constexpr absl::string_view kLabelPrefix = "tls13 ";
+  unsigned char hkdf_label[4 + kLabelPrefix.size() + 16];
+  size_t label_size = kLabelPrefix.size() + label.size();
+  if (label_size + 4 > sizeof(hkdf_label)) return false;
+  hkdf_label[0] = static_cast<unsigned char>(out_size >> 8);
+  hkdf_label[1] = static_cast<unsigned char>(out_size);
+  hkdf_label[2] = static_cast<unsigned char>(label_size);
+  memcpy(hkdf_label + 3, kLabelPrefix.data(), kLabelPrefix.size());
+  memcpy(hkdf_label + 3 + kLabelPrefix.size(), label.data(), label.size());
+  hkdf_label[3 + label_size] = 0;
+  return HKDF_expand(out, out_size, digest, secret.data(), secret.size(),
+                     hkdf_label, label_size + 4) == 1;
+}
+
+// Fills info with what the kernel needs to continue the write direction of
+// ssl: the AES-GCM key and salt, the initial explicit nonce and the sequence
+// number of the next record.
+static tsi_result ssl_get_kernel_tls_crypto_info(
+    const SSL* ssl, tsi_ssl_kernel_tls_crypto_info* info, size_t* info_size) {
+  const SSL_CIPHER* cipher = SSL_get_current_cipher(ssl);
+  if (cipher == nullptr) return TSI_FAILED_PRECONDITION;
+  tls_crypto_info* header;
+  unsigned char* key;
+  unsigned char* salt;
+  unsigned char* iv;
+  unsigned char* rec_seq;
+  size_t key_size;
+  const EVP_MD* digest;
+  switch (SSL_CIPHER_get_cipher_nid(cipher)) {
+    case NID_aes_128_gcm:
+      header = &info->aes_gcm_128.info;
+      header->cipher_type = TLS_CIPHER_AES_GCM_128;
+      key = info->aes_gcm_128.key;
+      salt = info->aes_gcm_128.salt;
+      iv = info->aes_gcm_128.iv;
+      rec_seq = info->aes_gcm_128.rec_seq;
+      key_size = TLS_CIPHER_AES_GCM_128_KEY_SIZE;
+      digest = EVP_sha256();
+      *info_size = sizeof(info->aes_gcm_128);
+      break;
+    case NID_aes_256_gcm:
+      header = &info->aes_gcm_256.info;
+      header->cipher_type = TLS_CIPHER_AES_GCM_256;
+      key = info->aes_gcm_256.key;
+      salt = info->aes_gcm_256.salt;
+      iv = info->aes_gcm_256.iv;
+      rec_seq = info->aes_gcm_256.rec_seq;
+      key_size = TLS_CIPHER_AES_GCM_256_KEY_SIZE;
+      digest = EVP_sha384();
+      *info_size = sizeof(info->aes_gcm_256);
+      break;
+    default:
+      return TSI_UNIMPLEMENTED;
+  }
+  uint64_t sequence = SSL_get_write_sequence(ssl);
+  for (int i = TLS_CIPHER_AES_GCM_128_REC_SEQ_SIZE - 1; i >= 0; --i) {
+    rec_seq[i] = static_cast<unsigned char>(sequence);
+    sequence >>= 8;
+  }
+  switch (SSL_version(ssl)) {
+    case TLS1_3_VERSION: {
+      header->version = TLS_1_3_VERSION;
+      // BoringSSL keeps the current traffic secrets once the handshake is
+      // done, so no keylog callback is needed to recover them.
+      bssl::Span<const uint8_t> read_secret;
+      bssl::Span<const uint8_t> secret;
+      if (!bssl::SSL_get_traffic_secrets(ssl, &read_secret, &secret) ||
+          secret.size() != EVP_MD_size(digest)) {
+        return TSI_FAILED_PRECONDITION;
+      }
+      // The kernel splits the 12 byte write IV into a 4 byte salt and 8 bytes
+      // that it XORs with the sequence number.
+      unsigned char write_iv[TLS_CIPHER_AES_GCM_128_SALT_SIZE +
+                             TLS_CIPHER_AES_GCM_128_IV_SIZE];
+      bool ok = ssl_hkdf_expand_label(digest, secret, "key", key, key_size) &&
+                ssl_hkdf_expand_label(digest, secret, "iv", write_iv,
+                                      sizeof(write_iv));
+      memcpy(salt, write_iv, TLS_CIPHER_AES_GCM_128_SALT_SIZE);
+      memcpy(iv, write_iv + TLS_CIPHER_AES_GCM_128_SALT_SIZE,
+             TLS_CIPHER_AES_GCM_128_IV_SIZE);
+      OPENSSL_cleanse(write_iv, sizeof(write_iv));
+      return ok ? TSI_OK : TSI_INTERNAL_ERROR;
+    }
+    case TLS1_2_VERSION: {
+      header->version = TLS_1_2_VERSION;
+      // AEAD suites have no MAC keys, so the key block is the client and
+      // server write keys followed by the client and server implicit nonces.
+      unsigned char key_block[2 * (TLS_CIPHER_AES_GCM_256_KEY_SIZE +
+                                   TLS_CIPHER_AES_GCM_128_SALT_SIZE)];
+      size_t key_block_size =
+          2 * (key_size + TLS_CIPHER_AES_GCM_128_SALT_SIZE);
+      if (SSL_get_key_block_len(ssl) != key_block_size ||
+          !SSL_generate_key_block(ssl, key_block, key_block_size)) {
+        return TSI_INTERNAL_ERROR;
+      }
+      bool is_server = SSL_is_server(ssl);
+      memcpy(key, key_block + (is_server ? key_size : 0), key_size);
+      memcpy(salt,
+             key_block + 2 * key_size +
+                 (is_server ? TLS_CIPHER_AES_GCM_128_SALT_SIZE : 0),
+             TLS_CIPHER_AES_GCM_128_SALT_SIZE);
+      OPENSSL_cleanse(key_block, sizeof(key_block));
+      // BoringSSL uses the sequence number as the explicit nonce, and so does
+      // the kernel once it is given as the initial one.
+      memcpy(iv, rec_seq, TLS_CIPHER_AES_GCM_128_IV_SIZE);
+      return TSI_OK;
+    }
+    default:
+      return TSI_UNIMPLEMENTED;
+  }
+}
+
+#endif  // GRPC_SSL_HAVE_KERNEL_TLS
+
+tsi_result tsi_ssl_handshaker_result_enable_kernel_tls_tx(
+    const tsi_handshaker_result* handshaker_result, int fd) {
+  if (handshaker_result == nullptr ||
+      handshaker_result->vtable != &handshaker_result_vtable) {
+    return TSI_UNIMPLEMENTED;
+  }
+#ifdef GRPC_SSL_HAVE_KERNEL_TLS
+  const tsi_ssl_handshaker_result* impl =
+      reinterpret_cast<const tsi_ssl_handshaker_result*>(handshaker_result);
+  if (impl->ssl == nullptr || fd < 0) return TSI_FAILED_PRECONDITION;
+  // Records BoringSSL has sealed but not handed out yet would otherwise be
+  // sealed a second time by the kernel.
+  if (BIO_ctrl_pending(impl->network_io) > 0) return TSI_FAILED_PRECONDITION;
+  tsi_ssl_kernel_tls_crypto_info info;
+  memset(&info, 0, sizeof(info));
+  size_t info_size = 0;
+  tsi_result result = ssl_get_kernel_tls_crypto_info(impl->ssl, &info,
+                                                     &info_size);
+  if (result == TSI_OK) {
+    // Once the ULP is attached but before TLS_TX is set, the socket still
+    // passes data through unchanged, so either failure leaves plain TCP.
+    if (setsockopt(fd, SOL_TCP, TCP_ULP, "tls", sizeof("tls")) != 0) {
+      GRPC_TRACE_LOG(tsi, INFO)
+          << "Kernel TLS is unavailable: " << grpc_core::StrError(errno);
+      result = TSI_UNIMPLEMENTED;
+    } else if (setsockopt(fd, SOL_TLS, TLS_TX, &info,
+                          static_cast<socklen_t>(info_size)) != 0) {
+      GRPC_TRACE_LOG(tsi, INFO) << "Kernel TLS rejected the session keys: "
+                                << grpc_core::StrError(errno);
+      result = TSI_UNIMPLEMENTED;
+    }
+  }
+  OPENSSL_cleanse(&info, sizeof(info));
+  return result;
+#else
+  (void)fd;
+  return TSI_UNIMPLEMENTED;
+#endif  // GRPC_SSL_HAVE_KERNEL_TLS
+}
+
 // --- tsi_ssl_handshaker_factory common methods. ---
 
 static void tsi_ssl_handshaker_resume_session(
@@ -410,6 +410,22 @@ void tsi_ssl_server_handshaker_factory_unref(
 // - handle public suffix wildchar more strictly (e.g. *.co.uk)
 int tsi_ssl_peer_matches_name(const tsi_peer* peer, absl::string_view name);
 
+// --- Kernel TLS offload. ---
+
+// Hands the write direction of an established TLS session over to the
+// kernel: the socket fd gets the "tls" upper layer protocol and the session's
+// AES-GCM write key, after which plaintext written to fd is sealed into TLS
+// records by the kernel. Reads are left to the frame protector.
+//- This method must be called before a frame protector is created from
+//  handshaker_result, and nothing may be protected with that protector
+//  afterwards.
+//- This method returns TSI_OK on success, TSI_UNIMPLEMENTED if the platform,
+//  the TLS version or the cipher suite is not supported, and another error if
+//  the session could not be offloaded. On error the socket is left carrying
+//  plain TCP and the caller should keep protecting writes in user space.
+tsi_result tsi_ssl_handshaker_result_enable_kernel_tls_tx(
+    const tsi_handshaker_result* handshaker_result, int fd);
+
 // --- Testing support. ---
 
 // These functions and typedefs are not intended to be used outside of testing.
@@ -19,6 +19,8 @@
 #include <inttypes.h>
 #include <stdlib.h>
 
+#include <string.h>
+
 #include <algorithm>
 #include <map>
 #include <string>
@@ -95,6 +97,12 @@ class JsonReader {
   struct Scope {
     std::string parent_object_key;
     absl::variant<Json::Object, Json::Array> data;
+    // Where SetKey() found the current key should go, so that a scalar value
+    // can be inserted without a second lookup. Only valid while
+    // has_key_hint is set, which is cleared as soon as a nested container
+    // starts, since that may move this scope.
+    Json::Object::iterator key_hint;
+    bool has_key_hint = false;
 
     Json::Type type() const {
       return Match(
@@ -117,10 +125,14 @@ class JsonReader {
   explicit JsonReader(absl::string_view input)
       : original_input_(reinterpret_cast<const uint8_t*>(input.data())),
         input_(original_input_),
-        remaining_input_(input.size()) {}
+        remaining_input_(input.size()) {
+    stack_.reserve(16);
+  }
 
   Status Run();
   uint32_t ReadChar();
+  void SkipWhitespace();
+  void ScanStringRun();
   bool IsComplete();
 
   size_t CurrentIndex() const { return input_ - original_input_ - 1; }
@@ -238,6 +250,59 @@ bool JsonReader::StringAddUtf32(uint32_t c) {
   }
 }
 
+constexpr uint64_t kEveryByte = ~uint64_t{0} / 255;
+
+// Word-at-a-time byte tests (see "Bit Twiddling Hacks"). Each returns a
+// non-zero value if any byte of `word` matches; a match can also flag bytes
+// after it, which is fine since callers only need to know whether the whole
+// word is free of matches.
+constexpr uint64_t HasZeroByte(uint64_t word) {
+  return (word - kEveryByte) & ~word & (kEveryByte * 0x80);
+}
+constexpr uint64_t HasByte(uint64_t word, uint8_t byte) {
+  return HasZeroByte(word ^ (kEveryByte * byte));
+}
+constexpr uint64_t HasByteLessThan(uint64_t word, uint8_t bound) {
+  return (word - kEveryByte * bound) & ~word & (kEveryByte * 0x80);
+}
+
+// True for bytes that a string can copy through without any further work:
+// printable ASCII other than the quote and the backslash.
+bool IsPlainStringByte(uint8_t c) {
+  return c >= 0x20 && c < 0x80 && c != '"' && c != '\\';
+}
+
+// Copies the run of plain bytes at the current position of a string straight
+// into string_, eight at a time where possible, leaving quotes, escapes,
+// control characters and UTF-8 sequences to the state machine.
+void JsonReader::ScanStringRun() {
+  const uint8_t* p = input_;
+  const uint8_t* const end = input_ + remaining_input_;
+  while (end - p >= 8) {
+    uint64_t word;
+    memcpy(&word, p, 8);
+    if (((word & (kEveryByte * 0x80)) | HasByteLessThan(word, 0x20) |
+         HasByte(word, '"') | HasByte(word, '\\')) != 0) {
+      break;
+    }
+    p += 8;
+  }
+  while (p != end && IsPlainStringByte(*p)) ++p;
+  string_.append(reinterpret_cast<const char*>(input_), p - input_);
+  remaining_input_ -= p - input_;
+  input_ = p;
+}
+
+// Skips insignificant whitespace in one go; pretty-printed configs are
+// mostly indentation.
+void JsonReader::SkipWhitespace() {
+  while (remaining_input_ != 0 && (*input_ == ' ' || *input_ == '\n' ||
+                                   *input_ == '\r' || *input_ == '\t')) {
+    ++input_;
+    --remaining_input_;
+  }
+}
+
 uint32_t JsonReader::ReadChar() {
   if (remaining_input_ == 0) return GRPC_JSON_READ_CHAR_EOF;
   const uint32_t r = *input_++;
@@ -251,9 +316,19 @@ uint32_t JsonReader::ReadChar() {
 
 Json* JsonReader::CreateAndLinkValue() {
   if (stack_.empty()) return &root_value_;
+  Scope& scope = stack_.back();
   return MatchMutable(
-      &stack_.back().data,
-      [&](Json::Object* object) { return &(*object)[std::move(key_)]; },
+      &scope.data,
+      [&](Json::Object* object) {
+        if (!scope.has_key_hint) return &(*object)[std::move(key_)];
+        scope.has_key_hint = false;
+        if (scope.key_hint != object->end() && scope.key_hint->first == key_) {
+          // Duplicate key, already reported: the last value wins.
+          return &scope.key_hint->second;
+        }
+        return &object->emplace_hint(scope.key_hint, std::move(key_), Json())
+                    ->second;
+      },
       [&](Json::Array* array) {
         array->emplace_back();
         return &array->back();
@@ -271,6 +346,7 @@ bool JsonReader::StartContainer(Json::Type type) {
     }
     return false;
   }
+  if (!stack_.empty()) stack_.back().has_key_hint = false;
   stack_.emplace_back();
   Scope& scope = stack_.back();
   scope.parent_object_key = std::move(key_);
@@ -295,8 +371,11 @@ void JsonReader::EndContainer() {
 void JsonReader::SetKey() {
   key_ = std::move(string_);
   string_.clear();
-  const Json::Object& object = absl::get<Json::Object>(stack_.back().data);
-  if (object.find(key_) != object.end()) {
+  Scope& scope = stack_.back();
+  Json::Object& object = absl::get<Json::Object>(scope.data);
+  scope.key_hint = object.lower_bound(key_);
+  scope.has_key_hint = true;
+  if (scope.key_hint != object.end() && scope.key_hint->first == key_) {
     if (errors_.size() == GRPC_JSON_MAX_ERRORS) {
       truncated_errors_ = true;
     } else {
@@ -351,6 +430,23 @@ JsonReader::Status JsonReader::Run() {
 
   // This state-machine is a strict implementation of ECMA-404
   while (true) {
+    switch (state_) {
+      case State::GRPC_JSON_STATE_OBJECT_KEY_STRING:
+      case State::GRPC_JSON_STATE_VALUE_STRING:
+        if (unicode_high_surrogate_ == 0 && utf8_bytes_remaining_ == 0) {
+          ScanStringRun();
+        }
+        break;
+      case State::GRPC_JSON_STATE_OBJECT_KEY_BEGIN:
+      case State::GRPC_JSON_STATE_OBJECT_KEY_END:
+      case State::GRPC_JSON_STATE_VALUE_BEGIN:
+      case State::GRPC_JSON_STATE_VALUE_END:
+      case State::GRPC_JSON_STATE_END:
+        SkipWhitespace();
+        break;
+      default:
+        break;
+    }
     c = ReadChar();
     switch (c) {
       // Let's process the error case first.
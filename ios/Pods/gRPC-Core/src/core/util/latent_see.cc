@@ -15,9 +15,12 @@
 #include "src/core/util/latent_see.h"
 
 #ifdef GRPC_ENABLE_LATENT_SEE
+#include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <cstdint>
+#include <cstdio>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -26,6 +29,7 @@
 #include "absl/types/optional.h"
 #include "src/core/util/ring_buffer.h"
 #include "src/core/util/sync.h"
+#include "src/core/util/thd.h"
 
 namespace grpc_core {
 namespace latent_see {
@@ -38,6 +42,154 @@ std::atomic<uintptr_t> Log::free_bins_{0};
 const std::chrono::steady_clock::time_point start_time =
     std::chrono::steady_clock::now();
 
+// Fixed-size ring of one thread's most recent events, for flight-recorder
+// mode. Only the owning thread writes, without locking; dumps read slots
+// concurrently under a per-slot seqlock and skip any slot that was overwritten
+// while it was being copied. About 400KiB per thread.
+class EventRing {
+ public:
+  static constexpr size_t kSize = 8192;
+
+  explicit EventRing(uint64_t thread_id) : thread_id_(thread_id) {}
+
+  void Append(uint64_t batch_id, const Bin::Event& event) {
+    const uint64_t seq = next_.load(std::memory_order_relaxed);
+    Slot& slot = slots_[seq % kSize];
+    slot.seq.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.metadata.store(event.metadata, std::memory_order_relaxed);
+    slot.timestamp.store(event.timestamp.time_since_epoch().count(),
+                         std::memory_order_relaxed);
+    slot.id.store(event.id, std::memory_order_relaxed);
+    slot.batch_id.store(batch_id, std::memory_order_relaxed);
+    slot.type.store(event.type, std::memory_order_relaxed);
+    slot.seq.store(seq + 1, std::memory_order_release);
+    next_.store(seq + 1, std::memory_order_release);
+  }
+
+  // Appends the events still held that happened at or after `since`.
+  void Snapshot(std::chrono::steady_clock::time_point since,
+                std::vector<Log::RecordedEvent>* out) const {
+    const uint64_t end = next_.load(std::memory_order_acquire);
+    for (uint64_t seq = end > kSize ? end - kSize : 0; seq < end; ++seq) {
+      const Slot& slot = slots_[seq % kSize];
+      const uint64_t before = slot.seq.load(std::memory_order_acquire);
+      Log::RecordedEvent recorded{
+          thread_id_, slot.batch_id.load(std::memory_order_relaxed),
+          Bin::Event{slot.metadata.load(std::memory_order_relaxed),
+                     std::chrono::steady_clock::time_point(
+                         std::chrono::steady_clock::duration(
+                             slot.timestamp.load(std::memory_order_relaxed))),
+                     slot.id.load(std::memory_order_relaxed),
+                     slot.type.load(std::memory_order_relaxed)}};
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (before != seq + 1 ||
+          slot.seq.load(std::memory_order_relaxed) != before) {
+        continue;
+      }
+      if (recorded.event.timestamp < since) continue;
+      out->push_back(recorded);
+    }
+  }
+
+ private:
+  struct Slot {
+    // One past the sequence number of the event held, or 0 while writing.
+    std::atomic<uint64_t> seq{0};
+    std::atomic<const Metadata*> metadata{nullptr};
+    std::atomic<std::chrono::steady_clock::rep> timestamp{0};
+    std::atomic<uint64_t> id{0};
+    std::atomic<uint64_t> batch_id{0};
+    std::atomic<EventType> type{EventType::kMark};
+  };
+
+  const uint64_t thread_id_;
+  std::atomic<uint64_t> next_{0};
+  Slot slots_[kSize];
+};
+
+// Owns the calling thread's ring, registering it with the log on first use
+// and unregistering it at thread exit.
+struct Log::ThreadRing {
+  ~ThreadRing() {
+    if (ring == nullptr) return;
+    Log& log = Log::Get();
+    MutexLock lock(&log.mu_rings_);
+    log.rings_.erase(std::find(log.rings_.begin(), log.rings_.end(),
+                               ring.get()));
+  }
+
+  EventRing* Get() {
+    if (ring == nullptr) {
+      ring = std::make_unique<EventRing>(thread_id_);
+      Log& log = Log::Get();
+      MutexLock lock(&log.mu_rings_);
+      log.rings_.push_back(ring.get());
+    }
+    return ring.get();
+  }
+
+  std::unique_ptr<EventRing> ring;
+};
+
+thread_local Log::ThreadRing Log::thread_ring_;
+
+namespace {
+
+void AppendEventJson(std::string* json, const Log::RecordedEvent& event) {
+  using Nanos = std::chrono::duration<unsigned long long, std::nano>;
+  absl::string_view phase;
+  bool has_id;
+  switch (event.event.type) {
+    case EventType::kBegin:
+      phase = "B";
+      has_id = false;
+      break;
+    case EventType::kEnd:
+      phase = "E";
+      has_id = false;
+      break;
+    case EventType::kFlowStart:
+      phase = "s";
+      has_id = true;
+      break;
+    case EventType::kFlowEnd:
+      phase = "f";
+      has_id = true;
+      break;
+    case EventType::kMark:
+      phase = "i";
+      has_id = false;
+      break;
+  }
+  if (event.event.metadata->name[0] != '"') {
+    absl::StrAppend(
+        json, "{\"name\": \"", event.event.metadata->name, "\", \"ph\": \"",
+        phase, "\", \"ts\": ",
+        Nanos(event.event.timestamp - start_time).count() / 1000.0,
+        ", \"pid\": 0, \"tid\": ", event.thread_id);
+  } else {
+    absl::StrAppend(
+        json, "{\"name\": ", event.event.metadata->name, ", \"ph\": \"",
+        phase, "\", \"ts\": ",
+        Nanos(event.event.timestamp - start_time).count() / 1000.0,
+        ", \"pid\": 0, \"tid\": ", event.thread_id);
+  }
+
+  if (has_id) {
+    absl::StrAppend(json, ", \"id\": ", event.event.id);
+  }
+  if (event.event.type == EventType::kFlowEnd) {
+    absl::StrAppend(json, ", \"bp\": \"e\"");
+  }
+  absl::StrAppend(json, ", \"args\": {\"file\": \"",
+                  event.event.metadata->file,
+                  "\", \"line\": ", event.event.metadata->line,
+                  ", \"batch\": ", event.batch_id, "}}");
+}
+
+}  // namespace
+
 void Log::TryPullEventsAndFlush(
     absl::FunctionRef<void(absl::Span<const RecordedEvent>)> callback) {
   // Try to lock... if we fail then clear the active events.
@@ -76,65 +228,17 @@ void Log::TryPullEventsAndFlush(
 }
 
 absl::optional<std::string> Log::TryGenerateJson() {
-  using Nanos = std::chrono::duration<unsigned long long, std::nano>;
   std::string json = "[\n";
   bool first = true;
   int callbacks = 0;
   TryPullEventsAndFlush([&](absl::Span<const RecordedEvent> events) {
     ++callbacks;
     for (const auto& event : events) {
-      absl::string_view phase;
-      bool has_id;
-      switch (event.event.type) {
-        case EventType::kBegin:
-          phase = "B";
-          has_id = false;
-          break;
-        case EventType::kEnd:
-          phase = "E";
-          has_id = false;
-          break;
-        case EventType::kFlowStart:
-          phase = "s";
-          has_id = true;
-          break;
-        case EventType::kFlowEnd:
-          phase = "f";
-          has_id = true;
-          break;
-        case EventType::kMark:
-          phase = "i";
-          has_id = false;
-          break;
-      }
       if (!first) {
         absl::StrAppend(&json, ",\n");
       }
       first = false;
-      if (event.event.metadata->name[0] != '"') {
-        absl::StrAppend(
-            &json, "{\"name\": \"", event.event.metadata->name,
-            "\", \"ph\": \"", phase, "\", \"ts\": ",
-            Nanos(event.event.timestamp - start_time).count() / 1000.0,
-            ", \"pid\": 0, \"tid\": ", event.thread_id);
-      } else {
-        absl::StrAppend(
-            &json, "{\"name\": ", event.event.metadata->name, ", \"ph\": \"",
-            phase, "\", \"ts\": ",
-            Nanos(event.event.timestamp - start_time).count() / 1000.0,
-            ", \"pid\": 0, \"tid\": ", event.thread_id);
-      }
-
-      if (has_id) {
-        absl::StrAppend(&json, ", \"id\": ", event.event.id);
-      }
-      if (event.event.type == EventType::kFlowEnd) {
-        absl::StrAppend(&json, ", \"bp\": \"e\"");
-      }
-      absl::StrAppend(&json, ", \"args\": {\"file\": \"",
-                      event.event.metadata->file,
-                      "\", \"line\": ", event.event.metadata->line,
-                      ", \"batch\": ", event.batch_id, "}}");
+      AppendEventJson(&json, event);
     }
   });
   if (callbacks == 0) return absl::nullopt;
@@ -142,11 +246,81 @@ absl::optional<std::string> Log::TryGenerateJson() {
   return json;
 }
 
+std::string Log::DumpFlightRecorder(std::chrono::nanoseconds window) {
+  return DumpFlightRecorderSince(std::chrono::steady_clock::now() - window);
+}
+
+std::string Log::DumpFlightRecorderSince(
+    std::chrono::steady_clock::time_point since) {
+  std::vector<RecordedEvent> events;
+  {
+    MutexLock lock(&mu_rings_);
+    for (EventRing* ring : rings_) ring->Snapshot(since, &events);
+  }
+  std::string json = "[\n";
+  for (size_t i = 0; i < events.size(); ++i) {
+    if (i != 0) absl::StrAppend(&json, ",\n");
+    AppendEventJson(&json, events[i]);
+  }
+  absl::StrAppend(&json, "\n]");
+  return json;
+}
+
+void Log::OnStall(const Metadata* metadata,
+                  std::chrono::nanoseconds duration) {
+  if (!flight_recorder_enabled() || duration < kStallDumpThreshold) return;
+  const int64_t now =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now() - start_time)
+          .count();
+  int64_t last = last_stall_dump_.load(std::memory_order_relaxed);
+  if (last != 0 &&
+      std::chrono::nanoseconds(now - last) < kStallDumpInterval) {
+    return;
+  }
+  if (!last_stall_dump_.compare_exchange_strong(last, now,
+                                                std::memory_order_relaxed)) {
+    return;
+  }
+  LOG(INFO) << metadata->name << " stalled for "
+            << std::chrono::duration_cast<std::chrono::milliseconds>(duration)
+                   .count()
+            << "ms; dumping latent_see flight recorder";
+  // Stalls are reported from transport threads: only note when the dump
+  // starts here, and leave snapshotting and writing it to a thread of its own.
+  const auto since = std::chrono::steady_clock::now() - kFlightRecorderWindow;
+  Thread dump_thread(
+      "latent_see_stall_dump",
+      [this, since]() {
+        Export("latent_see_stall.json", DumpFlightRecorderSince(since));
+      },
+      nullptr, Thread::Options().set_joinable(false).set_tracked(false));
+  dump_thread.Start();
+}
+
+void Log::Export(const char* filename, absl::string_view json) {
+  if (stats_flusher_ != nullptr) {
+    stats_flusher_(json);
+    return;
+  }
+  LOG(INFO) << "Writing " << filename << " in " << get_current_dir_name();
+  FILE* f = fopen(filename, "w");
+  if (f == nullptr) return;
+  fwrite(json.data(), 1, json.size(), f);
+  fclose(f);
+}
+
 void Log::FlushBin(Bin* bin) {
   if (bin->events.empty()) return;
   auto& log = Get();
   const auto batch_id =
       log.next_batch_id_.fetch_add(1, std::memory_order_relaxed);
+  if (log.flight_recorder_enabled()) {
+    EventRing* ring = thread_ring_.Get();
+    for (const auto& event : bin->events) ring->Append(batch_id, event);
+    bin->events.clear();
+    return;
+  }
   auto& fragment = log.fragments_.this_cpu();
   const auto thread_id = thread_id_;
   {
@@ -70,8 +70,17 @@ struct Bin {
   uintptr_t next_free = 0;
 };
 
+class EventRing;
+
 class Log {
  public:
+  // How much history the flight recorder dumps at exit.
+  static constexpr std::chrono::seconds kFlightRecorderWindow{10};
+  // Stalls shorter than this are not worth a dump.
+  static constexpr std::chrono::seconds kStallDumpThreshold{1};
+  // Minimum time between two stall-triggered dumps.
+  static constexpr std::chrono::seconds kStallDumpInterval{60};
+
   static constexpr uintptr_t kTagMask = (1ULL << TAGGED_POINTER_SIZE_BITS) - 1;
 
   struct RecordedEvent {
@@ -121,21 +130,16 @@ class Log {
   GPR_ATTRIBUTE_ALWAYS_INLINE_FUNCTION static Log& Get() {
     static Log* log = []() {
       atexit([] {
-        auto json = log->TryGenerateJson();
+        auto json = log->flight_recorder_enabled()
+                        ? absl::optional<std::string>(
+                              log->DumpFlightRecorder(kFlightRecorderWindow))
+                        : log->TryGenerateJson();
         if (!json.has_value()) {
           LOG(INFO) << "Failed to generate latent_see.json (contention with "
                        "another writer)";
           return;
         }
-        if (log->stats_flusher_ != nullptr) {
-          log->stats_flusher_(*json);
-          return;
-        }
-        LOG(INFO) << "Writing latent_see.json in " << get_current_dir_name();
-        FILE* f = fopen("latent_see.json", "w");
-        if (f == nullptr) return;
-        fprintf(f, "%s", json->c_str());
-        fclose(f);
+        log->Export("latent_see.json", *json);
       });
       return new Log();
     }();
@@ -146,23 +150,63 @@ class Log {
       absl::FunctionRef<void(absl::Span<const RecordedEvent>)> callback);
   absl::optional<std::string> TryGenerateJson();
 
+  // Flight-recorder mode: rather than accumulating events until the next
+  // TryPullEventsAndFlush(), each thread overwrites a fixed-size ring of its
+  // most recent events without taking any lock, so capture can stay on
+  // indefinitely. Enabled from the start when built with
+  // GRPC_LATENT_SEE_FLIGHT_RECORDER.
+  void EnableFlightRecorder() {
+    flight_recorder_.store(true, std::memory_order_relaxed);
+  }
+  bool flight_recorder_enabled() const {
+    return flight_recorder_.load(std::memory_order_relaxed);
+  }
+  // Renders the flight recorder's events from the last `window` as Chrome
+  // trace JSON (loadable in Perfetto).
+  std::string DumpFlightRecorder(std::chrono::nanoseconds window);
+  // Reports that the operation described by `metadata` was stalled for
+  // `duration`. In flight-recorder mode a long enough stall dumps the
+  // recorder, rate limited to one dump per kStallDumpInterval. The dump is
+  // written on a background thread; the caller only records the trigger.
+  void OnStall(const Metadata* metadata, std::chrono::nanoseconds duration);
+
   void OverrideStatsFlusher(
       absl::AnyInvocable<void(absl::string_view)> stats_exporter) {
     stats_flusher_ = std::move(stats_exporter);
   }
 
  private:
+  struct ThreadRing;
+
   Log() = default;
 
   static void FlushBin(Bin* bin);
 
+  std::string DumpFlightRecorderSince(
+      std::chrono::steady_clock::time_point since);
+
+  // Hands `json` to the stats flusher if one is set, else writes `filename`
+  // in the current directory.
+  void Export(const char* filename, absl::string_view json);
+
   std::atomic<uint64_t> next_thread_id_{1};
   std::atomic<uint64_t> next_batch_id_{1};
   static thread_local uint64_t thread_id_;
   static thread_local Bin* bin_;
   static thread_local void* bin_owner_;
   static std::atomic<uintptr_t> free_bins_;
+  static thread_local ThreadRing thread_ring_;
   absl::AnyInvocable<void(absl::string_view)> stats_flusher_ = nullptr;
+#ifdef GRPC_LATENT_SEE_FLIGHT_RECORDER
+  std::atomic<bool> flight_recorder_{true};
+#else
+  std::atomic<bool> flight_recorder_{false};
+#endif
+  std::atomic<int64_t> last_stall_dump_{0};
+  // Guards ring registration against concurrent dumps; never taken on the
+  // recording path once a thread has its ring.
+  Mutex mu_rings_;
+  std::vector<EventRing*> rings_ ABSL_GUARDED_BY(mu_rings_);
   Mutex mu_flushing_;
   struct Fragment {
     Mutex mu_active ABSL_ACQUIRED_AFTER(mu_flushing_);
@@ -300,6 +344,12 @@ GPR_ATTRIBUTE_ALWAYS_INLINE_FUNCTION auto Promise(const Metadata* md_poll,
 #define GRPC_LATENT_SEE_PROMISE(name, promise)                           \
   grpc_core::latent_see::Promise(GRPC_LATENT_SEE_METADATA("Poll:" name), \
                                  GRPC_LATENT_SEE_METADATA(name), promise)
+// Stall: reports that something was blocked for `duration` (a
+// std::chrono::duration). In flight-recorder mode this may dump the recent
+// past; `duration` is not evaluated when latent see is compiled out.
+#define GRPC_LATENT_SEE_STALL(name, duration)                               \
+  grpc_core::latent_see::Log::Get().OnStall(GRPC_LATENT_SEE_METADATA(name), \
+                                            duration)
 #else  // !def(GRPC_ENABLE_LATENT_SEE)
 namespace grpc_core {
 namespace latent_see {
@@ -329,6 +379,9 @@ struct InnerScope {
   do {                             \
   } while (0)
 #define GRPC_LATENT_SEE_PROMISE(name, promise) promise
+#define GRPC_LATENT_SEE_STALL(name, duration) \
+  do {                                        \
+  } while (0)
 #endif  // GRPC_ENABLE_LATENT_SEE
 
 #endif  // GRPC_SRC_CORE_UTIL_LATENT_SEE_H
@@ -118,6 +118,18 @@ Options SanitizeOptions(const std::string& dbname,
   return result;
 }
 
+// Returns a copy of "options" that compresses with the algorithm configured
+// for tables written to "level".
+static Options TableOptionsForLevel(const Options& options, int level) {
+  Options result = options;
+  const std::vector<CompressionType>& policy = options.compression_per_level;
+  if (!policy.empty()) {
+    const size_t index = static_cast<size_t>(level);
+    result.compression = policy[std::min(index, policy.size() - 1)];
+  }
+  return result;
+}
+
 static int TableCacheSize(const Options& sanitized_options) {
   // Reserve ten files or so for other uses and give the rest to TableCache.
   return sanitized_options.max_open_files - kNumNonTableCacheFiles;
@@ -511,7 +523,8 @@ Status DBImpl::WriteLevel0Table(MemTable* mem, VersionEdit* edit,
   Status s;
   {
     mutex_.Unlock();
-    s = BuildTable(dbname_, env_, options_, table_cache_, iter, &meta);
+    s = BuildTable(dbname_, env_, TableOptionsForLevel(options_, 0),
+                   table_cache_, iter, &meta);
     mutex_.Lock();
   }
 
@@ -812,7 +825,9 @@ Status DBImpl::OpenCompactionOutputFile(CompactionState* compact) {
   std::string fname = TableFileName(dbname_, file_number);
   Status s = env_->NewWritableFile(fname, &compact->outfile);
   if (s.ok()) {
-    compact->builder = new TableBuilder(options_, compact->outfile);
+    compact->builder = new TableBuilder(
+        TableOptionsForLevel(options_, compact->compaction->level() + 1),
+        compact->outfile);
   }
   return s;
 }
@@ -1154,6 +1169,88 @@ Status DBImpl::Get(const ReadOptions& options, const Slice& key,
   return s;
 }
 
+std::vector<Status> DBImpl::MultiGet(const ReadOptions& options,
+                                     const std::vector<Slice>& keys,
+                                     std::vector<std::string>* values) {
+  const size_t n = keys.size();
+  std::vector<Status> statuses(n);
+  values->assign(n, std::string());
+
+  MutexLock l(&mutex_);
+  SequenceNumber snapshot;
+  if (options.snapshot != nullptr) {
+    snapshot =
+        static_cast<const SnapshotImpl*>(options.snapshot)->sequence_number();
+  } else {
+    snapshot = versions_->LastSequence();
+  }
+
+  MemTable* mem = mem_;
+  MemTable* imm = imm_;
+  Version* current = versions_->current();
+  mem->Ref();
+  if (imm != nullptr) imm->Ref();
+  current->Ref();
+
+  std::vector<LookupKey*> lookup_keys;
+  std::vector<Version::GetRequest> requests;
+
+  // Unlock while reading from files and memtables
+  {
+    mutex_.Unlock();
+    // Visit the keys in sorted order so that Version::MultiGet() can step
+    // through files and blocks instead of searching for every key.
+    std::vector<size_t> order(n);
+    for (size_t i = 0; i < n; i++) {
+      order[i] = i;
+    }
+    const Comparator* ucmp = user_comparator();
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+      return ucmp->Compare(keys[a], keys[b]) < 0;
+    });
+
+    lookup_keys.reserve(n);
+    for (size_t i : order) {
+      LookupKey* lkey = new LookupKey(keys[i], snapshot);
+      lookup_keys.push_back(lkey);
+      // First look in the memtable, then in the immutable memtable (if any).
+      if (mem->Get(*lkey, &(*values)[i], &statuses[i])) {
+        // Done
+      } else if (imm != nullptr && imm->Get(*lkey, &(*values)[i],
+                                            &statuses[i])) {
+        // Done
+      } else {
+        Version::GetRequest request;
+        request.key = lkey;
+        request.value = &(*values)[i];
+        request.status = &statuses[i];
+        requests.push_back(request);
+      }
+    }
+    if (!requests.empty()) {
+      current->MultiGet(options, &requests);
+    }
+    mutex_.Lock();
+  }
+
+  bool schedule_compaction = false;
+  for (const Version::GetRequest& request : requests) {
+    if (current->UpdateStats(request.stats)) {
+      schedule_compaction = true;
+    }
+  }
+  if (schedule_compaction) {
+    MaybeScheduleCompaction();
+  }
+  mem->Unref();
+  if (imm != nullptr) imm->Unref();
+  current->Unref();
+  for (LookupKey* lkey : lookup_keys) {
+    delete lkey;
+  }
+  return statuses;
+}
+
 Iterator* DBImpl::NewIterator(const ReadOptions& options) {
   SequenceNumber latest_snapshot;
   uint32_t seed;
@@ -1473,6 +1570,18 @@ Status DB::Delete(const WriteOptions& opt, const Slice& key) {
   return Write(opt, &batch);
 }
 
+std::vector<Status> DB::MultiGet(const ReadOptions& options,
+                                 const std::vector<Slice>& keys,
+                                 std::vector<std::string>* values) {
+  std::vector<Status> statuses;
+  statuses.reserve(keys.size());
+  values->assign(keys.size(), std::string());
+  for (size_t i = 0; i < keys.size(); i++) {
+    statuses.push_back(Get(options, keys[i], &(*values)[i]));
+  }
+  return statuses;
+}
+
 DB::~DB() = default;
 
 Status DB::Open(const Options& options, const std::string& dbname, DB** dbptr) {
@@ -40,6 +40,13 @@ class TableCache {
              uint64_t file_size, const Slice& k, void* arg,
              void (*handle_result)(void*, const Slice&, const Slice&));
 
+  // Like Get() for each of the "n" sorted internal keys "keys", calling
+  // (*handle_result)(args[i], found_key, found_value) for keys[i].
+  Status MultiGet(const ReadOptions& options, uint64_t file_number,
+                  uint64_t file_size, const Slice* keys, void* const* args,
+                  size_t n,
+                  void (*handle_result)(void*, const Slice&, const Slice&));
+
   // Evict any entry for the specified file number
   void Evict(uint64_t file_number);
 
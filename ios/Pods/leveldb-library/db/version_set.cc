@@ -399,6 +399,139 @@ Status Version::Get(const ReadOptions& options, const LookupKey& k,
   return state.found ? state.s : Status::NotFound(Slice());
 }
 
+void Version::MultiGet(const ReadOptions& options,
+                       std::vector<GetRequest>* requests) {
+  const Comparator* ucmp = vset_->icmp_.user_comparator();
+
+  // Progress of one request; mirrors the State used by Get().
+  struct Lookup {
+    GetRequest* request;
+    Saver saver;
+    FileMetaData* last_file_read;
+    int last_file_read_level;
+    bool done;
+  };
+
+  std::vector<Lookup> lookups(requests->size());
+  for (size_t i = 0; i < lookups.size(); i++) {
+    Lookup* lookup = &lookups[i];
+    GetRequest* request = &(*requests)[i];
+    request->stats.seek_file = nullptr;
+    request->stats.seek_file_level = -1;
+    *request->status = Status::NotFound(Slice());
+    lookup->request = request;
+    lookup->saver.state = kNotFound;
+    lookup->saver.ucmp = ucmp;
+    lookup->saver.user_key = request->key->user_key();
+    lookup->saver.value = request->value;
+    lookup->last_file_read = nullptr;
+    lookup->last_file_read_level = -1;
+    lookup->done = false;
+  }
+
+  // Looks up every member of "group" in "f" with a single table lookup,
+  // then settles each of them as Get() would after reading "f".
+  std::vector<Lookup*> group;
+  std::vector<Slice> group_keys;
+  std::vector<void*> group_args;
+  auto read_group = [&](int level, FileMetaData* f) {
+    if (group.empty()) {
+      return;
+    }
+    group_keys.clear();
+    group_args.clear();
+    for (Lookup* lookup : group) {
+      GetStats* stats = &lookup->request->stats;
+      if (stats->seek_file == nullptr && lookup->last_file_read != nullptr) {
+        // We have had more than one seek for this read.  Charge the 1st file.
+        stats->seek_file = lookup->last_file_read;
+        stats->seek_file_level = lookup->last_file_read_level;
+      }
+      lookup->last_file_read = f;
+      lookup->last_file_read_level = level;
+      group_keys.push_back(lookup->request->key->internal_key());
+      group_args.push_back(&lookup->saver);
+    }
+
+    Status s = vset_->table_cache_->MultiGet(
+        options, f->number, f->file_size, group_keys.data(), group_args.data(),
+        group.size(), SaveValue);
+    for (Lookup* lookup : group) {
+      if (!s.ok()) {
+        *lookup->request->status = s;
+        lookup->done = true;
+        continue;
+      }
+      switch (lookup->saver.state) {
+        case kNotFound:
+          break;  // Keep searching in other files
+        case kFound:
+          *lookup->request->status = Status::OK();
+          lookup->done = true;
+          break;
+        case kDeleted:
+          lookup->done = true;
+          break;
+        case kCorrupt:
+          *lookup->request->status =
+              Status::Corruption("corrupted key for ", lookup->saver.user_key);
+          lookup->done = true;
+          break;
+      }
+    }
+    group.clear();
+  };
+
+  // Search level-0 in order from newest to oldest.  A request settled by
+  // a newer file is not looked up in older ones.
+  std::vector<FileMetaData*> tmp(files_[0]);
+  std::sort(tmp.begin(), tmp.end(), NewestFirst);
+  for (FileMetaData* f : tmp) {
+    for (Lookup& lookup : lookups) {
+      if (!lookup.done &&
+          ucmp->Compare(lookup.saver.user_key, f->smallest.user_key()) >= 0 &&
+          ucmp->Compare(lookup.saver.user_key, f->largest.user_key()) <= 0) {
+        group.push_back(&lookup);
+      }
+    }
+    read_group(0, f);
+  }
+
+  // Search other levels.  Files in a level are sorted and disjoint, so one
+  // forward pass over the sorted requests finds the file for each of them.
+  for (int level = 1; level < config::kNumLevels; level++) {
+    const std::vector<FileMetaData*>& files = files_[level];
+    const size_t num_files = files.size();
+    if (num_files == 0) continue;
+
+    size_t index = 0;
+    FileMetaData* group_file = nullptr;
+    for (Lookup& lookup : lookups) {
+      if (lookup.done) continue;
+
+      // Advance to the earliest file whose largest key >= internal_key.
+      const Slice ikey = lookup.request->key->internal_key();
+      while (index < num_files &&
+             vset_->icmp_.Compare(files[index]->largest.Encode(), ikey) < 0) {
+        index++;
+      }
+      if (index == num_files) break;
+
+      FileMetaData* f = files[index];
+      if (ucmp->Compare(lookup.saver.user_key, f->smallest.user_key()) < 0) {
+        // All of "f" is past any data for user_key
+        continue;
+      }
+      if (f != group_file) {
+        read_group(level, group_file);
+        group_file = f;
+      }
+      group.push_back(&lookup);
+    }
+    read_group(level, group_file);
+  }
+}
+
 bool Version::UpdateStats(const GetStats& stats) {
   FileMetaData* f = stats.seek_file;
   if (f != nullptr) {
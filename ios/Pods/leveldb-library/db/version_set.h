@@ -75,6 +75,20 @@ class Version {
   Status Get(const ReadOptions&, const LookupKey& key, std::string* val,
              GetStats* stats);
 
+  // One of the lookups performed by MultiGet().
+  struct GetRequest {
+    const LookupKey* key;
+    std::string* value;
+    Status* status;  // Set to the result of the lookup
+    GetStats stats;  // Filled as by Get()
+  };
+
+  // Perform each of "*requests" as if by Get(), sharing the file and
+  // table lookups between requests.
+  // REQUIRES: *requests is sorted by user key
+  // REQUIRES: lock is not held
+  void MultiGet(const ReadOptions&, std::vector<GetRequest>* requests);
+
   // Adds "stats" into the current state.  Returns true if a new
   // compaction may need to be triggered, false otherwise.
   // REQUIRES: lock is held
@@ -7,6 +7,8 @@
 
 #include <cstdint>
 #include <cstdio>
+#include <string>
+#include <vector>
 
 #include "leveldb/export.h"
 #include "leveldb/iterator.h"
@@ -87,6 +89,19 @@ class LEVELDB_EXPORT DB {
   virtual Status Get(const ReadOptions& options, const Slice& key,
                      std::string* value) = 0;
 
+  // Look up each of "keys" as if by Get(), storing the value found for
+  // keys[i] in (*values)[i] and returning the status of each lookup in the
+  // same order as "keys".  *values is resized to keys.size(); entries for
+  // keys that are not found are left empty.
+  //
+  // All keys are read from the same implicit snapshot (or from
+  // options.snapshot).  The keys are looked up in sorted order, sharing the
+  // memtable, version, table and block lookups between them, which is
+  // considerably cheaper than calling Get() once per key.
+  virtual std::vector<Status> MultiGet(const ReadOptions& options,
+                                       const std::vector<Slice>& keys,
+                                       std::vector<std::string>* values);
+
   // Return a heap-allocated iterator over the contents of the database.
   // The result of NewIterator() is initially invalid (caller must
   // call one of the Seek methods on the iterator before using it).
@@ -6,8 +6,10 @@
 #define STORAGE_LEVELDB_INCLUDE_OPTIONS_H_
 
 #include <cstddef>
+#include <vector>
 
 #include "leveldb/export.h"
+#include "leveldb/slice.h"
 
 namespace leveldb {
 
@@ -26,7 +28,9 @@ enum CompressionType {
   // NOTE: do not change the values of existing entries, as these are
   // part of the persistent format on disk.
   kNoCompression = 0x0,
-  kSnappyCompression = 0x1
+  kSnappyCompression = 0x1,
+  kZstdCompression = 0x2,
+  kLz4Compression = 0x3
 };
 
 // Options to control the behavior of a database (passed to DB::Open)
@@ -104,6 +108,17 @@ struct LEVELDB_EXPORT Options {
   // leave this parameter alone.
   int block_restart_interval = 16;
 
+  // If true, each data block is written with a small hash index that maps
+  // its keys to their restart interval, letting point lookups (Get) skip
+  // the binary search over the block's restart points at the cost of
+  // about one byte per key.  Blocks without the index remain readable, but
+  // tables written with this option cannot be read by versions of leveldb
+  // that predate it.  The hash index assumes that keys that compare equal
+  // under the comparator are bytewise equal.
+  //
+  // Default: false
+  bool data_block_hash_index = false;
+
   // Leveldb will write up to this amount of bytes to a file before
   // switching to a new one.
   // Most clients should leave this parameter alone.  However if your
@@ -130,6 +145,34 @@ struct LEVELDB_EXPORT Options {
   // efficiently detect that and will switch to uncompressed mode.
   CompressionType compression = kSnappyCompression;
 
+  // If non-empty, overrides "compression" for the tables written to each
+  // level: tables at level i use compression_per_level[i], and levels past
+  // the end of the vector use the last entry.  Memtable flushes always use
+  // the level-0 entry.  This lets hot, frequently rewritten levels use a
+  // fast algorithm such as kLz4Compression while colder levels use the
+  // better ratio of kZstdCompression.
+  //
+  // Default: empty (every level uses "compression")
+  std::vector<CompressionType> compression_per_level;
+
+  // Compression level for kZstdCompression; higher values compress better
+  // but more slowly.  Use a negative value for faster compression.
+  //
+  // Default: 1
+  int zstd_compression_level = 1;
+
+  // If non-empty, data blocks compressed with kZstdCompression are
+  // compressed against this dictionary, e.g. one trained with
+  // "zstd --train" over a sample of representative values.  Dictionaries
+  // substantially improve the ratio for small blocks of similar records.
+  // The dictionary is stored in each table file that uses it, so it may
+  // be changed or removed between opens without affecting existing data.
+  //
+  // REQUIRES: The storage backing the dictionary must outlive the DB.
+  //
+  // Default: empty (no dictionary)
+  Slice zstd_dictionary;
+
   // EXPERIMENTAL: If true, append to existing MANIFEST and log files
   // when a database is opened.  This can significantly speed up open.
   //
@@ -154,6 +197,13 @@ struct LEVELDB_EXPORT ReadOptions {
   // Callers may wish to set this field to false for bulk scans.
   bool fill_cache = true;
 
+  // If positive, an iterator that detects it is stepping forward through
+  // consecutive data blocks of a table hints the file system to start
+  // reading up to this many of the following blocks in the background.
+  // This speeds up long scans over data that is not in the block cache;
+  // point lookups and short scans are unaffected.
+  int readahead_blocks = 0;
+
   // If "snapshot" is non-null, read as of the supplied snapshot
   // (which must belong to the DB that is being read and which must
   // not have been released).  If "snapshot" is null, use an implicit
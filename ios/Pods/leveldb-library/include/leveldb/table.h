@@ -63,6 +63,7 @@ class LEVELDB_EXPORT Table {
   struct Rep;
 
   static Iterator* BlockReader(void*, const ReadOptions&, const Slice&);
+  static void PrefetchBlocks(void*, const ReadOptions&, const Slice&);
 
   explicit Table(Rep* rep) : rep_(rep) {}
 
@@ -73,8 +74,17 @@ class LEVELDB_EXPORT Table {
                      void (*handle_result)(void* arg, const Slice& k,
                                            const Slice& v));
 
+  // Like InternalGet() for each of the "n" keys in "keys", which must be
+  // sorted, calling (*handle_result)(args[i], ...) for keys[i].  Consecutive
+  // keys share index lookups and reads of the data blocks they fall in.
+  Status InternalMultiGet(const ReadOptions&, const Slice* keys,
+                          void* const* args, size_t n,
+                          void (*handle_result)(void* arg, const Slice& k,
+                                                const Slice& v));
+
   void ReadMeta(const Footer& footer);
   void ReadFilter(const Slice& filter_handle_value);
+  void ReadZstdDictionary(const Slice& dictionary_handle_value);
 
   Rep* const rep_;
 };
@@ -81,6 +81,48 @@ bool Snappy_GetUncompressedLength(const char* input, size_t length,
 bool Snappy_Uncompress(const char* input_data, size_t input_length,
                        char* output);
 
+// Store the zstd compression of "input[0,input_length-1]" in *output,
+// compressing against the raw dictionary "dict[0,dict_size-1]" if dict_size
+// is non-zero.  Returns false if zstd is not supported by this port.
+bool Zstd_Compress(int level, const char* input, size_t input_length,
+                   const char* dict, size_t dict_size, std::string* output);
+
+// If input[0,input_length-1] looks like a valid zstd compressed
+// buffer, store the size of the uncompressed data in *result and
+// return true.  Else return false.
+bool Zstd_GetUncompressedLength(const char* input, size_t length,
+                                size_t* result);
+
+// Attempt to zstd uncompress input[0,input_length-1] into *output using the
+// same dictionary that was passed to Zstd_Compress().  Returns true if
+// successful, false if the input is invalid zstd compressed data.
+//
+// REQUIRES: at least the first "n" bytes of output[] must be writable
+// where "n" is the result of a successful call to
+// Zstd_GetUncompressedLength.
+bool Zstd_Uncompress(const char* input_data, size_t input_length,
+                     const char* dict, size_t dict_size, char* output);
+
+// Store the lz4 compression of "input[0,input_length-1]" in *output.
+// Returns false if lz4 is not supported by this port.
+bool Lz4_Compress(const char* input, size_t input_length, std::string* output);
+
+// If input[0,input_length-1] looks like a valid lz4 compressed
+// buffer, store the size of the uncompressed data in *result and
+// return true.  Else return false.
+bool Lz4_GetUncompressedLength(const char* input, size_t length,
+                               size_t* result);
+
+// Attempt to lz4 uncompress input[0,input_length-1] into *output.
+// Returns true if successful, false if the input is invalid lz4
+// compressed data.
+//
+// REQUIRES: at least the first "n" bytes of output[] must be writable
+// where "n" is the result of a successful call to
+// Lz4_GetUncompressedLength.
+bool Lz4_Uncompress(const char* input_data, size_t input_length,
+                    char* output);
+
 // ------------------ Miscellaneous -------------------
 
 // If heap profiling is not supported, returns false.
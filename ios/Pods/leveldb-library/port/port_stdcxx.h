@@ -28,6 +28,12 @@
 #if HAVE_SNAPPY
 #include <snappy.h>
 #endif  // HAVE_SNAPPY
+#if HAVE_ZSTD
+#include <zstd.h>
+#endif  // HAVE_ZSTD
+#if HAVE_LZ4
+#include <lz4.h>
+#endif  // HAVE_LZ4
 
 #include <cassert>
 #include <condition_variable>  // NOLINT
@@ -126,6 +132,167 @@ inline bool Snappy_Uncompress(const char* input, size_t length, char* output) {
 #endif  // HAVE_SNAPPY
 }
 
+// Compresses "input" with zstd at "level".  If "dict_size" is non-zero the
+// input is compressed against the raw dictionary "dict", which must then be
+// supplied again to Zstd_Uncompress().
+inline bool Zstd_Compress(int level, const char* input, size_t length,
+                          const char* dict, size_t dict_size,
+                          std::string* output) {
+#if HAVE_ZSTD
+  // Get size of output buffer and resize.
+  size_t outlen = ZSTD_compressBound(length);
+  if (ZSTD_isError(outlen)) {
+    return false;
+  }
+  output->resize(outlen);
+  ZSTD_CCtx* ctx = ZSTD_createCCtx();
+  if (ctx == nullptr) {
+    return false;
+  }
+  outlen = ZSTD_compress_usingDict(ctx, &(*output)[0], output->size(), input,
+                                   length, dict, dict_size, level);
+  ZSTD_freeCCtx(ctx);
+  if (ZSTD_isError(outlen)) {
+    return false;
+  }
+  output->resize(outlen);
+  return true;
+#else
+  // Silence compiler warnings about unused arguments.
+  (void)level;
+  (void)input;
+  (void)length;
+  (void)dict;
+  (void)dict_size;
+  (void)output;
+  return false;
+#endif  // HAVE_ZSTD
+}
+
+inline bool Zstd_GetUncompressedLength(const char* input, size_t length,
+                                       size_t* result) {
+#if HAVE_ZSTD
+  unsigned long long size = ZSTD_getFrameContentSize(input, length);
+  if (size == ZSTD_CONTENTSIZE_UNKNOWN || size == ZSTD_CONTENTSIZE_ERROR) {
+    return false;
+  }
+  *result = static_cast<size_t>(size);
+  return true;
+#else
+  // Silence compiler warnings about unused arguments.
+  (void)input;
+  (void)length;
+  (void)result;
+  return false;
+#endif  // HAVE_ZSTD
+}
+
+// REQUIRES: "output" has room for the length reported by
+// Zstd_GetUncompressedLength(), and "dict" is the dictionary that was passed
+// to Zstd_Compress(), if any.
+inline bool Zstd_Uncompress(const char* input, size_t length, const char* dict,
+                            size_t dict_size, char* output) {
+#if HAVE_ZSTD
+  size_t outlen;
+  if (!Zstd_GetUncompressedLength(input, length, &outlen)) {
+    return false;
+  }
+  ZSTD_DCtx* ctx = ZSTD_createDCtx();
+  if (ctx == nullptr) {
+    return false;
+  }
+  outlen = ZSTD_decompress_usingDict(ctx, output, outlen, input, length, dict,
+                                     dict_size);
+  ZSTD_freeDCtx(ctx);
+  if (ZSTD_isError(outlen)) {
+    return false;
+  }
+  return true;
+#else
+  // Silence compiler warnings about unused arguments.
+  (void)input;
+  (void)length;
+  (void)dict;
+  (void)dict_size;
+  (void)output;
+  return false;
+#endif  // HAVE_ZSTD
+}
+
+// The raw LZ4 block format does not record the uncompressed length, so the
+// LZ4 helpers below prefix the compressed bytes with it as a fixed 32-bit
+// little-endian value.
+inline bool Lz4_Compress(const char* input, size_t length,
+                         std::string* output) {
+#if HAVE_LZ4
+  if (length > static_cast<size_t>(LZ4_MAX_INPUT_SIZE)) {
+    return false;
+  }
+  const int bound = LZ4_compressBound(static_cast<int>(length));
+  output->resize(4 + bound);
+  char* dst = &(*output)[0];
+  dst[0] = static_cast<char>(length & 0xff);
+  dst[1] = static_cast<char>((length >> 8) & 0xff);
+  dst[2] = static_cast<char>((length >> 16) & 0xff);
+  dst[3] = static_cast<char>((length >> 24) & 0xff);
+  const int outlen =
+      LZ4_compress_default(input, dst + 4, static_cast<int>(length), bound);
+  if (outlen <= 0) {
+    return false;
+  }
+  output->resize(4 + outlen);
+  return true;
+#else
+  // Silence compiler warnings about unused arguments.
+  (void)input;
+  (void)length;
+  (void)output;
+  return false;
+#endif  // HAVE_LZ4
+}
+
+inline bool Lz4_GetUncompressedLength(const char* input, size_t length,
+                                      size_t* result) {
+#if HAVE_LZ4
+  if (length < 4) {
+    return false;
+  }
+  const unsigned char* p = reinterpret_cast<const unsigned char*>(input);
+  *result = static_cast<size_t>(p[0]) | (static_cast<size_t>(p[1]) << 8) |
+            (static_cast<size_t>(p[2]) << 16) |
+            (static_cast<size_t>(p[3]) << 24);
+  return true;
+#else
+  // Silence compiler warnings about unused arguments.
+  (void)input;
+  (void)length;
+  (void)result;
+  return false;
+#endif  // HAVE_LZ4
+}
+
+// REQUIRES: "output" has room for the length reported by
+// Lz4_GetUncompressedLength().
+inline bool Lz4_Uncompress(const char* input, size_t length, char* output) {
+#if HAVE_LZ4
+  size_t outlen;
+  if (!Lz4_GetUncompressedLength(input, length, &outlen) ||
+      outlen > static_cast<size_t>(LZ4_MAX_INPUT_SIZE)) {
+    return false;
+  }
+  const int result =
+      LZ4_decompress_safe(input + 4, output, static_cast<int>(length - 4),
+                          static_cast<int>(outlen));
+  return result == static_cast<int>(outlen);
+#else
+  // Silence compiler warnings about unused arguments.
+  (void)input;
+  (void)length;
+  (void)output;
+  return false;
+#endif  // HAVE_LZ4
+}
+
 inline bool GetHeapProfile(void (*func)(void*, const char*, int), void* arg) {
   // Silence compiler warnings about unused arguments.
   (void)func;
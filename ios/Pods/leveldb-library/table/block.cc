@@ -11,31 +11,58 @@
 #include <vector>
 
 #include "leveldb/comparator.h"
+#include "table/block_builder.h"
 #include "table/format.h"
 #include "util/coding.h"
+#include "util/hash.h"
 #include "util/logging.h"
 
 namespace leveldb {
 
 inline uint32_t Block::NumRestarts() const {
   assert(size_ >= sizeof(uint32_t));
-  return DecodeFixed32(data_ + size_ - sizeof(uint32_t));
+  return DecodeFixed32(data_ + size_ - sizeof(uint32_t)) &
+         ~kBlockHashIndexFlag;
 }
 
 Block::Block(const BlockContents& contents)
     : data_(contents.data.data()),
       size_(contents.data.size()),
-      owned_(contents.heap_allocated) {
+      owned_(contents.heap_allocated),
+      hash_buckets_(nullptr),
+      num_hash_buckets_(0),
+      hash_key_suffix_length_(0) {
   if (size_ < sizeof(uint32_t)) {
     size_ = 0;  // Error marker
-  } else {
-    size_t max_restarts_allowed = (size_ - sizeof(uint32_t)) / sizeof(uint32_t);
-    if (NumRestarts() > max_restarts_allowed) {
-      // The size is too small for NumRestarts()
+    return;
+  }
+
+  // Size of the block less its trailer
+  size_t limit = size_ - sizeof(uint32_t);
+  if ((DecodeFixed32(data_ + limit) & kBlockHashIndexFlag) != 0) {
+    if (limit < sizeof(uint32_t) + 1) {
       size_ = 0;
-    } else {
-      restart_offset_ = (uint32_t)size_ - (1 + NumRestarts()) * sizeof(uint32_t);
+      return;
     }
+    limit -= sizeof(uint32_t);
+    num_hash_buckets_ = DecodeFixed32(data_ + limit);
+    limit -= 1;
+    hash_key_suffix_length_ = static_cast<uint8_t>(data_[limit]);
+    if (num_hash_buckets_ == 0 || num_hash_buckets_ > limit) {
+      // The size is too small for the hash index
+      size_ = 0;
+      return;
+    }
+    limit -= num_hash_buckets_;
+    hash_buckets_ = reinterpret_cast<const uint8_t*>(data_ + limit);
+  }
+
+  size_t max_restarts_allowed = limit / sizeof(uint32_t);
+  if (NumRestarts() > max_restarts_allowed) {
+    // The size is too small for NumRestarts()
+    size_ = 0;
+  } else {
+    restart_offset_ = (uint32_t)(limit - NumRestarts() * sizeof(uint32_t));
   }
 }
 
@@ -80,6 +107,7 @@ class Block::Iter : public Iterator {
   const char* const data_;       // underlying block contents
   uint32_t const restarts_;      // Offset of restart array (list of fixed32)
   uint32_t const num_restarts_;  // Number of uint32_t entries in restart array
+  const Block* const block_;     // For the hash index, if any
 
   // current_ is offset in data_ of current entry.  >= restarts_ if !Valid
   uint32_t current_;
@@ -113,12 +141,13 @@ class Block::Iter : public Iterator {
   }
 
  public:
-  Iter(const Comparator* comparator, const char* data, uint32_t restarts,
+  Iter(const Comparator* comparator, const Block* block, uint32_t restarts,
        uint32_t num_restarts)
       : comparator_(comparator),
-        data_(data),
+        data_(block->data_),
         restarts_(restarts),
         num_restarts_(num_restarts),
+        block_(block),
         current_(restarts_),
         restart_index_(num_restarts_) {
     assert(num_restarts_ > 0);
@@ -162,6 +191,10 @@ class Block::Iter : public Iterator {
   }
 
   void Seek(const Slice& target) override {
+    if (block_->hash_buckets_ != nullptr && SeekUsingHashIndex(target)) {
+      return;
+    }
+
     // Binary search in restart array to find the last restart point
     // with a key < target
     uint32_t left = 0;
@@ -214,6 +247,55 @@ class Block::Iter : public Iterator {
   }
 
  private:
+  // Returns "key" less the trailing bytes that the hash index ignores.
+  Slice HashedKey(const Slice& key) const {
+    const size_t suffix = block_->hash_key_suffix_length_;
+    return Slice(key.data(),
+                 key.size() > suffix ? key.size() - suffix : key.size());
+  }
+
+  // Tries to position the iterator at the first key >= target by scanning
+  // only the restart interval that the hash index maps target to, which
+  // saves the binary search for point lookups of keys in the block.
+  // Returns false, having possibly moved the iterator, if the hash index
+  // cannot answer; the caller must then do a full Seek().
+  bool SeekUsingHashIndex(const Slice& target) {
+    const Slice hashed_target = HashedKey(target);
+    const uint32_t hash =
+        Hash(hashed_target.data(), hashed_target.size(), kBlockHashSeed);
+    const uint8_t restart =
+        block_->hash_buckets_[hash % block_->num_hash_buckets_];
+    if (restart >= num_restarts_) {
+      // No key with this hash, or several restart intervals share it.
+      return false;
+    }
+
+    SeekToRestartPoint(restart);
+    if (!ParseNextKey()) {
+      return true;  // Corruption
+    }
+    // Every key before the restart point is smaller than the key there.
+    // That key is <= target, or it is a version of target's user key,
+    // all of whose versions are in this restart interval since its bucket
+    // is not a collision.  In either case every key before the restart
+    // point is < target.  Otherwise the bucket belongs to another key.
+    if (Compare(key_, target) > 0 && HashedKey(key_) != hashed_target) {
+      return false;
+    }
+    const uint32_t limit = static_cast<uint32_t>(restart + 1) < num_restarts_
+                               ? GetRestartPoint(restart + 1)
+                               : restarts_;
+    while (Compare(key_, target) < 0) {
+      if (!ParseNextKey()) {
+        return true;  // Past the last key, or corruption
+      }
+      if (current_ >= limit) {
+        return false;  // Target is not in this restart interval
+      }
+    }
+    return true;
+  }
+
   void CorruptionError() {
     current_ = restarts_;
     restart_index_ = num_restarts_;
@@ -260,7 +342,7 @@ Iterator* Block::NewIterator(const Comparator* comparator) {
   if (num_restarts == 0) {
     return NewEmptyIterator();
   } else {
-    return new Iter(comparator, data_, restart_offset_, num_restarts);
+    return new Iter(comparator, this, restart_offset_, num_restarts);
   }
 }
 
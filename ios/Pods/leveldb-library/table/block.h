@@ -37,6 +37,11 @@ class Block {
   size_t size_;
   uint32_t restart_offset_;  // Offset in data_ of restart array
   bool owned_;               // Block owns data_[]
+
+  // Hash index, if the block has one (see block_builder.cc)
+  const uint8_t* hash_buckets_;     // nullptr if the block has no hash index
+  uint32_t num_hash_buckets_;
+  uint8_t hash_key_suffix_length_;  // Trailing key bytes left out of hashes
 };
 
 }  // namespace leveldb
@@ -25,20 +25,51 @@
 //     restarts: uint32[num_restarts]
 //     num_restarts: uint32
 // restarts[i] contains the offset within the block of the ith restart point.
+//
+// If Options::data_block_hash_index is set, the trailer instead has the
+// form:
+//     restarts: uint32[num_restarts]
+//     buckets: uint8[num_buckets]
+//     hash_key_suffix_length: uint8
+//     num_buckets: uint32
+//     num_restarts | kBlockHashIndexFlag: uint32
+// buckets[Hash(k) % num_buckets] holds the index of the restart interval
+// that contains every entry whose key, less its final
+// hash_key_suffix_length bytes, is k; or kBlockHashNoEntry if there is
+// no such key, or kBlockHashCollision if several restart intervals hash
+// to the bucket.  For tables written by a DB the suffix is the 8-byte
+// sequence number and type of an internal key, so all versions of a user
+// key share a bucket.  Blocks with too many restart points for a uint8
+// bucket are written without the hash index.
 
 #include "table/block_builder.h"
 
 #include <algorithm>
 #include <cassert>
+#include <cstring>
 
 #include "leveldb/comparator.h"
 #include "leveldb/options.h"
 #include "util/coding.h"
+#include "util/hash.h"
 
 namespace leveldb {
 
+// Keys of tables written by a DB are internal keys; leave their sequence
+// number and type out of the hash so that lookups at any snapshot find
+// the bucket of the user key.
+static uint8_t HashKeySuffixLength(const Comparator* comparator) {
+  return strcmp(comparator->Name(), "leveldb.InternalKeyComparator") == 0 ? 8
+                                                                           : 0;
+}
+
 BlockBuilder::BlockBuilder(const Options* options)
-    : options_(options), restarts_(), counter_(0), finished_(false) {
+    : options_(options),
+      restarts_(),
+      counter_(0),
+      finished_(false),
+      hash_index_(options->data_block_hash_index),
+      hash_key_suffix_length_(HashKeySuffixLength(options->comparator)) {
   assert(options->block_restart_interval >= 1);
   restarts_.push_back(0);  // First restart point is at offset 0
 }
@@ -50,12 +81,24 @@ void BlockBuilder::Reset() {
   counter_ = 0;
   finished_ = false;
   last_key_.clear();
+  hash_index_ = options_->data_block_hash_index;
+  hash_key_suffix_length_ = HashKeySuffixLength(options_->comparator);
+  key_hashes_.clear();
+}
+
+uint32_t BlockBuilder::NumHashBuckets() const {
+  // Aim for a load factor of 0.75.
+  return static_cast<uint32_t>(key_hashes_.size() * 4 / 3 + 1);
 }
 
 size_t BlockBuilder::CurrentSizeEstimate() const {
-  return (buffer_.size() +                       // Raw data buffer
-          restarts_.size() * sizeof(uint32_t) +  // Restart array
-          sizeof(uint32_t));                     // Restart array length
+  size_t estimate = (buffer_.size() +                       // Raw data buffer
+                     restarts_.size() * sizeof(uint32_t) +  // Restart array
+                     sizeof(uint32_t));  // Restart array length
+  if (hash_index_) {
+    estimate += NumHashBuckets() + 1 + sizeof(uint32_t);
+  }
+  return estimate;
 }
 
 Slice BlockBuilder::Finish() {
@@ -63,7 +106,27 @@ Slice BlockBuilder::Finish() {
   for (size_t i = 0; i < restarts_.size(); i++) {
     PutFixed32(&buffer_, restarts_[i]);
   }
-  PutFixed32(&buffer_, (uint32_t)restarts_.size());
+  if (hash_index_ && restarts_.size() <= kBlockHashCollision) {
+    // Append hash index
+    const uint32_t num_buckets = NumHashBuckets();
+    const size_t buckets_offset = buffer_.size();
+    buffer_.append(num_buckets, static_cast<char>(kBlockHashNoEntry));
+    for (const auto& key_hash : key_hashes_) {
+      char* bucket = &buffer_[buckets_offset + key_hash.first % num_buckets];
+      const uint8_t restart = static_cast<uint8_t>(key_hash.second);
+      if (static_cast<uint8_t>(*bucket) == kBlockHashNoEntry) {
+        *bucket = static_cast<char>(restart);
+      } else if (static_cast<uint8_t>(*bucket) != restart) {
+        *bucket = static_cast<char>(kBlockHashCollision);
+      }
+    }
+    buffer_.push_back(static_cast<char>(hash_key_suffix_length_));
+    PutFixed32(&buffer_, num_buckets);
+    PutFixed32(&buffer_,
+               static_cast<uint32_t>(restarts_.size()) | kBlockHashIndexFlag);
+  } else {
+    PutFixed32(&buffer_, (uint32_t)restarts_.size());
+  }
   finished_ = true;
   return Slice(buffer_);
 }
@@ -97,6 +160,20 @@ void BlockBuilder::Add(const Slice& key, const Slice& value) {
   buffer_.append(key.data() + shared, non_shared);
   buffer_.append(value.data(), value.size());
 
+  if (hash_index_) {
+    // Record the restart interval holding this key.  Consecutive versions
+    // of the same key in one interval need only one entry.
+    const size_t hashed_size = key.size() > hash_key_suffix_length_
+                                   ? key.size() - hash_key_suffix_length_
+                                   : key.size();
+    const uint32_t hash = Hash(key.data(), hashed_size, kBlockHashSeed);
+    const uint32_t restart = static_cast<uint32_t>(restarts_.size() - 1);
+    if (key_hashes_.empty() || key_hashes_.back().first != hash ||
+        key_hashes_.back().second != restart) {
+      key_hashes_.emplace_back(hash, restart);
+    }
+  }
+
   // Update state
   last_key_.resize(shared);
   last_key_.append(key.data() + shared, non_shared);
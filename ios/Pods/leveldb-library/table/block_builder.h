@@ -6,6 +6,8 @@
 #define STORAGE_LEVELDB_TABLE_BLOCK_BUILDER_H_
 
 #include <cstdint>
+#include <string>
+#include <utility>
 #include <vector>
 
 #include "leveldb/slice.h"
@@ -14,6 +16,12 @@ namespace leveldb {
 
 struct Options;
 
+// Trailer of a block with a hash index; see block_builder.cc.
+static const uint32_t kBlockHashIndexFlag = 1u << 31;
+static const uint8_t kBlockHashNoEntry = 255;
+static const uint8_t kBlockHashCollision = 254;
+static const uint32_t kBlockHashSeed = 0x7a3c9e15;
+
 class BlockBuilder {
  public:
   explicit BlockBuilder(const Options* options);
@@ -41,12 +49,18 @@ class BlockBuilder {
   bool empty() const { return buffer_.empty(); }
 
  private:
+  uint32_t NumHashBuckets() const;
+
   const Options* options_;
   std::string buffer_;              // Destination buffer
   std::vector<uint32_t> restarts_;  // Restart points
   int counter_;                     // Number of entries emitted since restart
   bool finished_;                   // Has Finish() been called?
   std::string last_key_;
+  bool hash_index_;                 // Append a hash index in Finish()?
+  uint8_t hash_key_suffix_length_;  // Trailing key bytes left out of hashes
+  // (Key hash, restart index) for each distinct key in the block.
+  std::vector<std::pair<uint32_t, uint32_t>> key_hashes_;
 };
 
 }  // namespace leveldb
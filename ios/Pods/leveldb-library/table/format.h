@@ -84,10 +84,18 @@ struct BlockContents {
   bool heap_allocated;  // True iff caller should delete[] data.data()
 };
 
+// Name of the meta block holding the dictionary that the table's
+// kZstdCompression data blocks were compressed against, if any.
+static const char kZstdDictionaryBlockName[] = "compression.zstd.dictionary";
+
 // Read the block identified by "handle" from "file".  On failure
 // return non-OK.  On success fill *result and return OK.
+//
+// "zstd_dictionary" must be the dictionary the block was compressed
+// against, or empty if it was compressed without one.
 Status ReadBlock(RandomAccessFile* file, const ReadOptions& options,
-                 const BlockHandle& handle, BlockContents* result);
+                 const BlockHandle& handle, const Slice& zstd_dictionary,
+                 BlockContents* result);
 
 // Implementation details follow.  Clients should ignore,
 
@@ -21,6 +21,7 @@ struct Table::Rep {
   ~Rep() {
     delete filter;
     delete[] filter_data;
+    delete[] zstd_dictionary_data;
     delete index_block;
   }
 
@@ -31,6 +32,10 @@ struct Table::Rep {
   FilterBlockReader* filter;
   const char* filter_data;
 
+  // Dictionary that the data blocks were compressed against, if any.
+  Slice zstd_dictionary;
+  const char* zstd_dictionary_data;
+
   BlockHandle metaindex_handle;  // Handle to metaindex_block: saved from footer
   Block* index_block;
 };
@@ -58,7 +63,8 @@ Status Table::Open(const Options& options, RandomAccessFile* file,
   if (options.paranoid_checks) {
     opt.verify_checksums = true;
   }
-  s = ReadBlock(file, opt, footer.index_handle(), &index_block_contents);
+  s = ReadBlock(file, opt, footer.index_handle(), Slice(),
+                &index_block_contents);
 
   if (s.ok()) {
     // We've successfully read the footer and the index block: we're
@@ -72,6 +78,7 @@ Status Table::Open(const Options& options, RandomAccessFile* file,
     rep->cache_id = (options.block_cache ? options.block_cache->NewId() : 0);
     rep->filter_data = nullptr;
     rep->filter = nullptr;
+    rep->zstd_dictionary_data = nullptr;
     *table = new Table(rep);
     (*table)->ReadMeta(footer);
   }
@@ -80,34 +87,65 @@ Status Table::Open(const Options& options, RandomAccessFile* file,
 }
 
 void Table::ReadMeta(const Footer& footer) {
-  if (rep_->options.filter_policy == nullptr) {
-    return;  // Do not need any metadata
+  // An empty metaindex block consists of just its restart array: a single
+  // restart offset plus the restart count.  Such tables carry no metadata.
+  if (footer.metaindex_handle().size() <= 2 * sizeof(uint32_t)) {
+    return;
   }
 
-  // TODO(sanjay): Skip this if footer.metaindex_handle() size indicates
-  // it is an empty block.
   ReadOptions opt;
   if (rep_->options.paranoid_checks) {
     opt.verify_checksums = true;
   }
   BlockContents contents;
-  if (!ReadBlock(rep_->file, opt, footer.metaindex_handle(), &contents).ok()) {
+  if (!ReadBlock(rep_->file, opt, footer.metaindex_handle(), Slice(),
+                 &contents)
+           .ok()) {
     // Do not propagate errors since meta info is not needed for operation
     return;
   }
   Block* meta = new Block(contents);
 
   Iterator* iter = meta->NewIterator(BytewiseComparator());
-  std::string key = "filter.";
-  key.append(rep_->options.filter_policy->Name());
-  iter->Seek(key);
-  if (iter->Valid() && iter->key() == Slice(key)) {
-    ReadFilter(iter->value());
+  iter->Seek(kZstdDictionaryBlockName);
+  if (iter->Valid() && iter->key() == Slice(kZstdDictionaryBlockName)) {
+    ReadZstdDictionary(iter->value());
+  }
+  if (rep_->options.filter_policy != nullptr) {
+    std::string key = "filter.";
+    key.append(rep_->options.filter_policy->Name());
+    iter->Seek(key);
+    if (iter->Valid() && iter->key() == Slice(key)) {
+      ReadFilter(iter->value());
+    }
   }
   delete iter;
   delete meta;
 }
 
+void Table::ReadZstdDictionary(const Slice& dictionary_handle_value) {
+  Slice v = dictionary_handle_value;
+  BlockHandle dictionary_handle;
+  if (!dictionary_handle.DecodeFrom(&v).ok()) {
+    return;
+  }
+
+  // Data blocks compressed against the dictionary fail to decompress
+  // without it, so the error surfaces on the first read of such a block.
+  ReadOptions opt;
+  if (rep_->options.paranoid_checks) {
+    opt.verify_checksums = true;
+  }
+  BlockContents block;
+  if (!ReadBlock(rep_->file, opt, dictionary_handle, Slice(), &block).ok()) {
+    return;
+  }
+  if (block.heap_allocated) {
+    rep_->zstd_dictionary_data = block.data.data();  // Delete later
+  }
+  rep_->zstd_dictionary = block.data;
+}
+
 void Table::ReadFilter(const Slice& filter_handle_value) {
   Slice v = filter_handle_value;
   BlockHandle filter_handle;
@@ -122,7 +160,7 @@ void Table::ReadFilter(const Slice& filter_handle_value) {
     opt.verify_checksums = true;
   }
   BlockContents block;
-  if (!ReadBlock(rep_->file, opt, filter_handle, &block).ok()) {
+  if (!ReadBlock(rep_->file, opt, filter_handle, Slice(), &block).ok()) {
     return;
   }
   if (block.heap_allocated) {
@@ -174,7 +212,8 @@ Iterator* Table::BlockReader(void* arg, const ReadOptions& options,
       if (cache_handle != nullptr) {
         block = reinterpret_cast<Block*>(block_cache->Value(cache_handle));
       } else {
-        s = ReadBlock(table->rep_->file, options, handle, &contents);
+        s = ReadBlock(table->rep_->file, options, handle,
+                      table->rep_->zstd_dictionary, &contents);
         if (s.ok()) {
           block = new Block(contents);
           if (contents.cachable && options.fill_cache) {
@@ -184,7 +223,8 @@ Iterator* Table::BlockReader(void* arg, const ReadOptions& options,
         }
       }
     } else {
-      s = ReadBlock(table->rep_->file, options, handle, &contents);
+      s = ReadBlock(table->rep_->file, options, handle,
+                    table->rep_->zstd_dictionary, &contents);
       if (s.ok()) {
         block = new Block(contents);
       }
@@ -205,10 +245,42 @@ Iterator* Table::BlockReader(void* arg, const ReadOptions& options,
   return iter;
 }
 
+// Hint the file to start reading the options.readahead_blocks data blocks
+// that follow the block whose index entry has key "index_key".  Blocks are
+// laid out contiguously, so this is a single range.
+void Table::PrefetchBlocks(void* arg, const ReadOptions& options,
+                           const Slice& index_key) {
+  Table* table = reinterpret_cast<Table*>(arg);
+  Iterator* iiter =
+      table->rep_->index_block->NewIterator(table->rep_->options.comparator);
+  iiter->Seek(index_key);
+  uint64_t start = 0;
+  uint64_t limit = 0;
+  for (int i = 0; iiter->Valid() && i <= options.readahead_blocks; i++) {
+    BlockHandle handle;
+    Slice input = iiter->value();
+    if (!handle.DecodeFrom(&input).ok()) {
+      break;
+    }
+    if (i == 0) {
+      start = handle.offset() + handle.size() + kBlockTrailerSize;
+    } else {
+      limit = handle.offset() + handle.size() + kBlockTrailerSize;
+    }
+    iiter->Next();
+  }
+  delete iiter;
+
+  if (limit > start) {
+    table->rep_->file->Prefetch(start, static_cast<size_t>(limit - start));
+  }
+}
+
 Iterator* Table::NewIterator(const ReadOptions& options) const {
   return NewTwoLevelIterator(
       rep_->index_block->NewIterator(rep_->options.comparator),
-      &Table::BlockReader, const_cast<Table*>(this), options);
+      &Table::BlockReader, &Table::PrefetchBlocks, const_cast<Table*>(this),
+      options);
 }
 
 Status Table::InternalGet(const ReadOptions& options, const Slice& k, void* arg,
@@ -241,6 +313,51 @@ Status Table::InternalGet(const ReadOptions& options, const Slice& k, void* arg,
   return s;
 }
 
+Status Table::InternalMultiGet(const ReadOptions& options, const Slice* keys,
+                               void* const* args, size_t n,
+                               void (*handle_result)(void*, const Slice&,
+                                                     const Slice&)) {
+  Status s;
+  const Comparator* comparator = rep_->options.comparator;
+  FilterBlockReader* filter = rep_->filter;
+  Iterator* iiter = rep_->index_block->NewIterator(comparator);
+  Iterator* block_iter = nullptr;
+  Slice block_index_value;  // Index entry that block_iter was created from
+  for (size_t i = 0; i < n && s.ok(); i++) {
+    // The keys are sorted, so if the index entry found for the previous key
+    // is not before this key, it is also the first entry >= this key.
+    if (i == 0 || comparator->Compare(iiter->key(), keys[i]) < 0) {
+      iiter->Seek(keys[i]);
+    }
+    if (!iiter->Valid()) {
+      break;  // This key and all the following ones are past the table.
+    }
+
+    Slice handle_value = iiter->value();
+    BlockHandle handle;
+    if (filter != nullptr && handle.DecodeFrom(&handle_value).ok() &&
+        !filter->KeyMayMatch(handle.offset(), keys[i])) {
+      continue;  // Not found
+    }
+    if (block_iter == nullptr || iiter->value() != block_index_value) {
+      delete block_iter;
+      block_iter = BlockReader(this, options, iiter->value());
+      block_index_value = iiter->value();
+    }
+    block_iter->Seek(keys[i]);
+    if (block_iter->Valid()) {
+      (*handle_result)(args[i], block_iter->key(), block_iter->value());
+    }
+    s = block_iter->status();
+  }
+  delete block_iter;
+  if (s.ok()) {
+    s = iiter->status();
+  }
+  delete iiter;
+  return s;
+}
+
 uint64_t Table::ApproximateOffsetOf(const Slice& key) const {
   Iterator* index_iter =
       rep_->index_block->NewIterator(rep_->options.comparator);
@@ -31,8 +31,10 @@ struct TableBuilder::Rep {
         filter_block(opt.filter_policy == nullptr
                          ? nullptr
                          : new FilterBlockBuilder(opt.filter_policy)),
-        pending_index_entry(false) {
+        pending_index_entry(false),
+        zstd_dictionary_used(false) {
     index_block_options.block_restart_interval = 1;
+    index_block_options.data_block_hash_index = false;
   }
 
   Options options;
@@ -60,6 +62,10 @@ struct TableBuilder::Rep {
   BlockHandle pending_handle;  // Handle to add to index block
 
   std::string compressed_output;
+
+  // True once a data block has been compressed against
+  // options.zstd_dictionary, which must then be stored in the table.
+  bool zstd_dictionary_used;
 };
 
 TableBuilder::TableBuilder(const Options& options, WritableFile* file)
@@ -82,12 +88,18 @@ Status TableBuilder::ChangeOptions(const Options& options) {
   if (options.comparator != rep_->options.comparator) {
     return Status::InvalidArgument("changing comparator while building table");
   }
+  if (rep_->zstd_dictionary_used &&
+      options.zstd_dictionary != rep_->options.zstd_dictionary) {
+    return Status::InvalidArgument(
+        "changing zstd dictionary while building table");
+  }
 
   // Note that any live BlockBuilders point to rep_->options and therefore
   // will automatically pick up the updated options.
   rep_->options = options;
   rep_->index_block_options = options;
   rep_->index_block_options.block_restart_interval = 1;
+  rep_->index_block_options.data_block_hash_index = false;
   return Status::OK();
 }
 
@@ -149,6 +161,10 @@ void TableBuilder::WriteBlock(BlockBuilder* block, BlockHandle* handle) {
 
   Slice block_contents;
   CompressionType type = r->options.compression;
+  // The zstd dictionary only applies to data blocks: the index and
+  // metaindex blocks must be readable before the dictionary is loaded.
+  const Slice dictionary =
+      (block == &r->data_block) ? r->options.zstd_dictionary : Slice();
   // TODO(postrelease): Support more compression options: zlib?
   switch (type) {
     case kNoCompression:
@@ -168,6 +184,39 @@ void TableBuilder::WriteBlock(BlockBuilder* block, BlockHandle* handle) {
       }
       break;
     }
+
+    case kZstdCompression: {
+      std::string* compressed = &r->compressed_output;
+      if (port::Zstd_Compress(r->options.zstd_compression_level, raw.data(),
+                              raw.size(), dictionary.data(), dictionary.size(),
+                              compressed) &&
+          compressed->size() < raw.size() - (raw.size() / 8u)) {
+        block_contents = *compressed;
+        if (!dictionary.empty()) {
+          r->zstd_dictionary_used = true;
+        }
+      } else {
+        // Zstd not supported, or compressed less than 12.5%, so just
+        // store uncompressed form
+        block_contents = raw;
+        type = kNoCompression;
+      }
+      break;
+    }
+
+    case kLz4Compression: {
+      std::string* compressed = &r->compressed_output;
+      if (port::Lz4_Compress(raw.data(), raw.size(), compressed) &&
+          compressed->size() < raw.size() - (raw.size() / 8u)) {
+        block_contents = *compressed;
+      } else {
+        // Lz4 not supported, or compressed less than 12.5%, so just
+        // store uncompressed form
+        block_contents = raw;
+        type = kNoCompression;
+      }
+      break;
+    }
   }
   WriteRawBlock(block_contents, type, handle);
   r->compressed_output.clear();
@@ -201,7 +250,8 @@ Status TableBuilder::Finish() {
   assert(!r->closed);
   r->closed = true;
 
-  BlockHandle filter_block_handle, metaindex_block_handle, index_block_handle;
+  BlockHandle filter_block_handle, metaindex_block_handle, index_block_handle,
+      dictionary_block_handle;
 
   // Write filter block
   if (ok() && r->filter_block != nullptr) {
@@ -209,9 +259,24 @@ Status TableBuilder::Finish() {
                   &filter_block_handle);
   }
 
+  // Write zstd dictionary block
+  if (ok() && r->zstd_dictionary_used) {
+    WriteRawBlock(r->options.zstd_dictionary, kNoCompression,
+                  &dictionary_block_handle);
+  }
+
   // Write metaindex block
   if (ok()) {
-    BlockBuilder meta_index_block(&r->options);
+    Options meta_index_block_options = r->options;
+    meta_index_block_options.data_block_hash_index = false;
+    BlockBuilder meta_index_block(&meta_index_block_options);
+    if (r->zstd_dictionary_used) {
+      // Add mapping from the dictionary name to the location of its data.
+      // Keys must be added in sorted order, so this precedes "filter.".
+      std::string handle_encoding;
+      dictionary_block_handle.EncodeTo(&handle_encoding);
+      meta_index_block.Add(kZstdDictionaryBlockName, handle_encoding);
+    }
     if (r->filter_block != nullptr) {
       // Add mapping from "filter.Name" to location of filter data
       std::string key = "filter.";
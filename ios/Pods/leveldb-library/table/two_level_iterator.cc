@@ -4,6 +4,8 @@
 
 #include "table/two_level_iterator.h"
 
+#include <algorithm>
+
 #include "leveldb/table.h"
 #include "table/block.h"
 #include "table/format.h"
@@ -14,11 +16,17 @@ namespace leveldb {
 namespace {
 
 typedef Iterator* (*BlockFunction)(void*, const ReadOptions&, const Slice&);
+typedef void (*PrefetchFunction)(void*, const ReadOptions&, const Slice&);
+
+// Number of consecutive forward block transitions after which a scan is
+// considered sequential and readahead starts.
+static const int kSequentialBlocksBeforeReadahead = 2;
 
 class TwoLevelIterator : public Iterator {
  public:
   TwoLevelIterator(Iterator* index_iter, BlockFunction block_function,
-                   void* arg, const ReadOptions& options);
+                   PrefetchFunction prefetch_function, void* arg,
+                   const ReadOptions& options);
 
   ~TwoLevelIterator() override;
 
@@ -56,8 +64,11 @@ class TwoLevelIterator : public Iterator {
   void SkipEmptyDataBlocksBackward();
   void SetDataIterator(Iterator* data_iter);
   void InitDataBlock();
+  void ResetReadahead();
+  void NoteForwardBlockTransition();
 
   BlockFunction block_function_;
+  PrefetchFunction prefetch_function_;  // May be nullptr
   void* arg_;
   const ReadOptions options_;
   Status status_;
@@ -66,20 +77,29 @@ class TwoLevelIterator : public Iterator {
   // If data_iter_ is non-null, then "data_block_handle_" holds the
   // "index_value" passed to block_function_ to create the data_iter_.
   std::string data_block_handle_;
+  // Readahead state: the number of consecutive blocks entered by moving
+  // forward, and how many more to enter before prefetching again.
+  int sequential_blocks_;
+  int blocks_until_prefetch_;
 };
 
 TwoLevelIterator::TwoLevelIterator(Iterator* index_iter,
-                                   BlockFunction block_function, void* arg,
-                                   const ReadOptions& options)
+                                   BlockFunction block_function,
+                                   PrefetchFunction prefetch_function,
+                                   void* arg, const ReadOptions& options)
     : block_function_(block_function),
+      prefetch_function_(prefetch_function),
       arg_(arg),
       options_(options),
       index_iter_(index_iter),
-      data_iter_(nullptr) {}
+      data_iter_(nullptr),
+      sequential_blocks_(0),
+      blocks_until_prefetch_(0) {}
 
 TwoLevelIterator::~TwoLevelIterator() = default;
 
 void TwoLevelIterator::Seek(const Slice& target) {
+  ResetReadahead();
   index_iter_.Seek(target);
   InitDataBlock();
   if (data_iter_.iter() != nullptr) data_iter_.Seek(target);
@@ -87,6 +107,7 @@ void TwoLevelIterator::Seek(const Slice& target) {
 }
 
 void TwoLevelIterator::SeekToFirst() {
+  ResetReadahead();
   index_iter_.SeekToFirst();
   InitDataBlock();
   if (data_iter_.iter() != nullptr) data_iter_.SeekToFirst();
@@ -94,6 +115,7 @@ void TwoLevelIterator::SeekToFirst() {
 }
 
 void TwoLevelIterator::SeekToLast() {
+  ResetReadahead();
   index_iter_.SeekToLast();
   InitDataBlock();
   if (data_iter_.iter() != nullptr) data_iter_.SeekToLast();
@@ -120,6 +142,7 @@ void TwoLevelIterator::SkipEmptyDataBlocksForward() {
       return;
     }
     index_iter_.Next();
+    NoteForwardBlockTransition();
     InitDataBlock();
     if (data_iter_.iter() != nullptr) data_iter_.SeekToFirst();
   }
@@ -133,6 +156,7 @@ void TwoLevelIterator::SkipEmptyDataBlocksBackward() {
       return;
     }
     index_iter_.Prev();
+    ResetReadahead();
     InitDataBlock();
     if (data_iter_.iter() != nullptr) data_iter_.SeekToLast();
   }
@@ -160,12 +184,47 @@ void TwoLevelIterator::InitDataBlock() {
   }
 }
 
+void TwoLevelIterator::ResetReadahead() {
+  sequential_blocks_ = 0;
+  blocks_until_prefetch_ = 0;
+}
+
+void TwoLevelIterator::NoteForwardBlockTransition() {
+  if (prefetch_function_ == nullptr || options_.readahead_blocks <= 0 ||
+      !index_iter_.Valid()) {
+    return;
+  }
+  if (sequential_blocks_ < kSequentialBlocksBeforeReadahead) {
+    ++sequential_blocks_;
+    if (sequential_blocks_ < kSequentialBlocksBeforeReadahead) {
+      return;
+    }
+  }
+  if (blocks_until_prefetch_ > 0) {
+    --blocks_until_prefetch_;
+    return;
+  }
+  (*prefetch_function_)(arg_, options_, index_iter_.key());
+  // Each prefetch covers readahead_blocks blocks; refresh the window once
+  // half of it has been consumed so that the reads stay ahead of the scan.
+  blocks_until_prefetch_ = std::max(1, options_.readahead_blocks / 2) - 1;
+}
+
 }  // namespace
 
 Iterator* NewTwoLevelIterator(Iterator* index_iter,
                               BlockFunction block_function, void* arg,
                               const ReadOptions& options) {
-  return new TwoLevelIterator(index_iter, block_function, arg, options);
+  return new TwoLevelIterator(index_iter, block_function, nullptr, arg,
+                              options);
+}
+
+Iterator* NewTwoLevelIterator(Iterator* index_iter,
+                              BlockFunction block_function,
+                              PrefetchFunction prefetch_function, void* arg,
+                              const ReadOptions& options) {
+  return new TwoLevelIterator(index_iter, block_function, prefetch_function,
+                              arg, options);
 }
 
 }  // namespace leveldb
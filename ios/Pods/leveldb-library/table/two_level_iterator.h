@@ -26,6 +26,19 @@ Iterator* NewTwoLevelIterator(
                                 const Slice& index_value),
     void* arg, const ReadOptions& options);
 
+// Like the above, but if options.readahead_blocks is positive and the
+// iterator detects a forward scan over consecutive blocks, it periodically
+// calls (*prefetch_function)(arg, options, index_key) with the key of the
+// index entry for the block it just entered, so that the blocks following
+// that one can be fetched ahead of time.
+Iterator* NewTwoLevelIterator(
+    Iterator* index_iter,
+    Iterator* (*block_function)(void* arg, const ReadOptions& options,
+                                const Slice& index_value),
+    void (*prefetch_function)(void* arg, const ReadOptions& options,
+                              const Slice& index_key),
+    void* arg, const ReadOptions& options);
+
 }  // namespace leveldb
 
 #endif  // STORAGE_LEVELDB_TABLE_TWO_LEVEL_ITERATOR_H_
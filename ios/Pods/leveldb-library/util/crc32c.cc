@@ -12,6 +12,27 @@
 #include "port/port.h"
 #include "util/coding.h"
 
+// Unless LEVELDB_DISABLE_HARDWARE_CRC32C is defined, GCC and Clang builds for
+// x86-64 and AArch64 carry an implementation based on the SSE4.2 / ARMv8 CRC32C
+// instructions, selected at runtime when the CPU supports them.
+#if !defined(LEVELDB_DISABLE_HARDWARE_CRC32C) && \
+    (defined(__GNUC__) || defined(__clang__))
+#if defined(__x86_64__)
+#define LEVELDB_HARDWARE_CRC32C_X86 1
+#include <nmmintrin.h>
+#elif defined(__aarch64__)
+#define LEVELDB_HARDWARE_CRC32C_ARM64 1
+#include <arm_acle.h>
+#if defined(__linux__)
+#include <sys/auxv.h>
+#endif  // defined(__linux__)
+#endif  // defined(__x86_64__)
+#endif  // !defined(LEVELDB_DISABLE_HARDWARE_CRC32C) && ...
+
+#if LEVELDB_HARDWARE_CRC32C_X86 || LEVELDB_HARDWARE_CRC32C_ARM64
+#define LEVELDB_HARDWARE_CRC32C 1
+#endif
+
 namespace leveldb {
 namespace crc32c {
 
@@ -262,6 +283,175 @@ constexpr inline const uint8_t* RoundUp(const uint8_t* pointer) {
 
 }  // namespace
 
+#if LEVELDB_HARDWARE_CRC32C
+
+namespace {
+
+#if LEVELDB_HARDWARE_CRC32C_X86
+#define LEVELDB_HARDWARE_CRC32C_TARGET __attribute__((target("sse4.2")))
+
+LEVELDB_HARDWARE_CRC32C_TARGET inline uint32_t HardwareStep1(uint32_t crc,
+                                                             uint8_t v) {
+  return _mm_crc32_u8(crc, v);
+}
+
+LEVELDB_HARDWARE_CRC32C_TARGET inline uint32_t HardwareStep8(uint32_t crc,
+                                                             uint64_t v) {
+  return static_cast<uint32_t>(_mm_crc32_u64(crc, v));
+}
+
+bool CanUseHardwareCRC32C() { return __builtin_cpu_supports("sse4.2"); }
+
+#elif LEVELDB_HARDWARE_CRC32C_ARM64
+#if defined(__clang__)
+#define LEVELDB_HARDWARE_CRC32C_TARGET __attribute__((target("crc")))
+#else
+#define LEVELDB_HARDWARE_CRC32C_TARGET __attribute__((target("+crc")))
+#endif  // defined(__clang__)
+
+LEVELDB_HARDWARE_CRC32C_TARGET inline uint32_t HardwareStep1(uint32_t crc,
+                                                             uint8_t v) {
+  return __crc32cb(crc, v);
+}
+
+LEVELDB_HARDWARE_CRC32C_TARGET inline uint32_t HardwareStep8(uint32_t crc,
+                                                             uint64_t v) {
+  return __crc32cd(crc, v);
+}
+
+bool CanUseHardwareCRC32C() {
+#if defined(__APPLE__)
+  // Every 64-bit Apple CPU implements the ARMv8 CRC32 extension.
+  return true;
+#elif defined(__linux__)
+  // HWCAP_CRC32 from <asm/hwcap.h>, which is not available everywhere.
+  static constexpr unsigned long kHwcapCrc32 = 1ul << 7;
+  return (getauxval(AT_HWCAP) & kHwcapCrc32) != 0;
+#else
+  return false;
+#endif  // defined(__APPLE__)
+}
+
+#endif  // LEVELDB_HARDWARE_CRC32C_X86
+
+// The CRC32C instructions have a latency of three cycles but a throughput of
+// one per cycle, so long buffers are split into three equally sized streams
+// whose CRCs are computed in an interleaved fashion and combined afterwards.
+//
+// Combining relies on the CRC being linear: the CRC of A followed by B equals
+// the CRC of B on its own xor'ed with the CRC of A "shifted" over |B| zero
+// bytes.  The shift for a fixed stream length is a linear map on 32-bit
+// values, precomputed below as four byte-indexed tables.
+constexpr size_t kLongStreamSize = 1024;
+constexpr size_t kShortStreamSize = 128;
+
+struct ShiftTable {
+  uint32_t table[4][256];
+
+  uint32_t Shift(uint32_t crc) const {
+    return table[0][crc & 0xff] ^ table[1][(crc >> 8) & 0xff] ^
+           table[2][(crc >> 16) & 0xff] ^ table[3][crc >> 24];
+  }
+};
+
+LEVELDB_HARDWARE_CRC32C_TARGET void InitShiftTable(size_t stream_size,
+                                                   ShiftTable* shift) {
+  // The shift of each single-bit value, found by running it over zeros.
+  uint32_t bit_shift[32];
+  for (int bit = 0; bit < 32; ++bit) {
+    uint32_t crc = 1u << bit;
+    for (size_t i = 0; i < stream_size; i += 8) {
+      crc = HardwareStep8(crc, 0);
+    }
+    bit_shift[bit] = crc;
+  }
+  for (int byte = 0; byte < 4; ++byte) {
+    for (uint32_t value = 0; value < 256; ++value) {
+      uint32_t crc = 0;
+      for (int bit = 0; bit < 8; ++bit) {
+        if (value & (1u << bit)) {
+          crc ^= bit_shift[byte * 8 + bit];
+        }
+      }
+      shift->table[byte][value] = crc;
+    }
+  }
+}
+
+struct ShiftTables {
+  ShiftTables() {
+    InitShiftTable(kLongStreamSize, &long_streams);
+    InitShiftTable(kShortStreamSize, &short_streams);
+  }
+
+  ShiftTable long_streams;
+  ShiftTable short_streams;
+};
+
+// Consumes as many runs of three "stream_size"-byte streams from [*p, e) as
+// possible.
+LEVELDB_HARDWARE_CRC32C_TARGET inline uint32_t HardwareExtendStreams(
+    uint32_t l, const uint8_t** p, const uint8_t* e, size_t stream_size,
+    const ShiftTable& shift) {
+  const uint8_t* q = *p;
+  while (static_cast<size_t>(e - q) >= 3 * stream_size) {
+    uint32_t crc0 = l;
+    uint32_t crc1 = 0;
+    uint32_t crc2 = 0;
+    const uint8_t* end0 = q + stream_size;
+    for (; q != end0; q += 8) {
+      crc0 = HardwareStep8(
+          crc0, DecodeFixed64(reinterpret_cast<const char*>(q)));
+      crc1 = HardwareStep8(crc1, DecodeFixed64(reinterpret_cast<const char*>(
+                                     q + stream_size)));
+      crc2 = HardwareStep8(crc2, DecodeFixed64(reinterpret_cast<const char*>(
+                                     q + 2 * stream_size)));
+    }
+    q += 2 * stream_size;
+    l = shift.Shift(shift.Shift(crc0) ^ crc1) ^ crc2;
+  }
+  *p = q;
+  return l;
+}
+
+LEVELDB_HARDWARE_CRC32C_TARGET uint32_t HardwareExtend(uint32_t crc,
+                                                       const char* data,
+                                                       size_t n) {
+  static const ShiftTables* const shift_tables = new ShiftTables();
+
+  const uint8_t* p = reinterpret_cast<const uint8_t*>(data);
+  const uint8_t* e = p + n;
+  uint32_t l = crc ^ kCRC32Xor;
+
+  // Align the 8-byte loads below.
+  const uint8_t* x = RoundUp<8>(p);
+  if (x <= e) {
+    while (p != x) {
+      l = HardwareStep1(l, *p++);
+    }
+  }
+
+  l = HardwareExtendStreams(l, &p, e, kLongStreamSize,
+                            shift_tables->long_streams);
+  l = HardwareExtendStreams(l, &p, e, kShortStreamSize,
+                            shift_tables->short_streams);
+
+  while ((e - p) >= 8) {
+    l = HardwareStep8(l, DecodeFixed64(reinterpret_cast<const char*>(p)));
+    p += 8;
+  }
+  while (p != e) {
+    l = HardwareStep1(l, *p++);
+  }
+  return l ^ kCRC32Xor;
+}
+
+#undef LEVELDB_HARDWARE_CRC32C_TARGET
+
+}  // namespace
+
+#endif  // LEVELDB_HARDWARE_CRC32C
+
 // Determine if the CPU running this program can accelerate the CRC32C
 // calculation.
 static bool CanAccelerateCRC32C() {
@@ -278,6 +468,12 @@ uint32_t Extend(uint32_t crc, const char* data, size_t n) {
   if (accelerate) {
     return port::AcceleratedCRC32C(crc, data, n);
   }
+#if LEVELDB_HARDWARE_CRC32C
+  static bool hardware = CanUseHardwareCRC32C();
+  if (hardware) {
+    return HardwareExtend(crc, data, n);
+  }
+#endif  // LEVELDB_HARDWARE_CRC32C
 
   const uint8_t* p = reinterpret_cast<const uint8_t*>(data);
   const uint8_t* e = p + n;
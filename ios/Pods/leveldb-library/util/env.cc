@@ -32,6 +32,8 @@ SequentialFile::~SequentialFile() = default;
 
 RandomAccessFile::~RandomAccessFile() = default;
 
+void RandomAccessFile::Prefetch(uint64_t /*offset*/, size_t /*n*/) const {}
+
 WritableFile::~WritableFile() = default;
 
 Logger::~Logger() = default;
@@ -12,6 +12,7 @@
 #include <sys/types.h>
 #include <unistd.h>
 
+#include <algorithm>
 #include <atomic>
 #include <cerrno>
 #include <cstddef>
@@ -195,6 +196,34 @@ class PosixRandomAccessFile final : public RandomAccessFile {
     return status;
   }
 
+  void Prefetch(uint64_t offset, size_t n) const override {
+    int fd = fd_;
+    if (!has_permanent_fd_) {
+      // The hint populates the page cache, which outlives the descriptor.
+      fd = ::open(filename_.c_str(), O_RDONLY | kOpenBaseFlags);
+      if (fd < 0) {
+        return;
+      }
+    }
+
+    // Failures are ignored: this is only a hint.
+#if defined(F_RDADVISE)
+    struct radvisory advice;
+    advice.ra_offset = static_cast<off_t>(offset);
+    advice.ra_count = static_cast<int>(
+        std::min<size_t>(n, std::numeric_limits<int>::max()));
+    ::fcntl(fd, F_RDADVISE, &advice);
+#elif defined(POSIX_FADV_WILLNEED)
+    ::posix_fadvise(fd, static_cast<off_t>(offset), static_cast<off_t>(n),
+                    POSIX_FADV_WILLNEED);
+#endif  // defined(F_RDADVISE)
+
+    if (!has_permanent_fd_) {
+      assert(fd != fd_);
+      ::close(fd);
+    }
+  }
+
  private:
   const bool has_permanent_fd_;  // If false, the file is opened on every read.
   const int fd_;                 // -1 if has_permanent_fd_ is false.
@@ -239,6 +268,19 @@ class PosixMmapReadableFile final : public RandomAccessFile {
     return Status::OK();
   }
 
+  void Prefetch(uint64_t offset, size_t n) const override {
+    if (offset >= length_) {
+      return;
+    }
+    n = std::min<size_t>(n, length_ - offset);
+
+    // madvise() requires a page-aligned address; mmap_base_ is one.
+    static const size_t kPageSize = ::sysconf(_SC_PAGESIZE);
+    const size_t aligned_offset = offset - offset % kPageSize;
+    ::madvise(static_cast<void*>(mmap_base_ + aligned_offset),
+              n + (offset - aligned_offset), MADV_WILLNEED);
+  }
+
  private:
   char* const mmap_base_;
   const size_t length_;
@@ -532,6 +532,22 @@ static bool checkreturn allocate_field(pb_istream_t *stream, void *pData, size_t
     return true;
 }
 
+/* Returns the number of entries to reserve for a dynamically allocated
+ * repeated field holding count entries: the smallest power of two that is
+ * at least count, capped at PB_SIZE_MAX. Decoded arrays always have at least
+ * this many entries allocated, so appending only has to reallocate when the
+ * count reaches a power of two.
+ */
+static size_t pb_array_capacity(size_t count)
+{
+    size_t capacity = 1;
+    if (count == 0)
+        return 0;
+    while (capacity < count && capacity <= PB_SIZE_MAX / 2)
+        capacity *= 2;
+    return (capacity < count) ? (size_t)PB_SIZE_MAX : capacity;
+}
+
 /* Clear a newly allocated item in case it contains a pointer, or is a submessage. */
 static void initialize_pointer_field(void *pItem, pb_field_iter_t *iter)
 {
@@ -629,6 +645,7 @@ static bool checkreturn decode_pointer_field(pb_istream_t *stream, pb_wire_type_
                             allocated_size += remain;
                         else
                             allocated_size += 1;
+                        allocated_size = pb_array_capacity(allocated_size);
                         
                         if (!allocate_field(&substream, iter->pData, iter->pos->data_size, allocated_size))
                         {
@@ -661,15 +678,21 @@ static bool checkreturn decode_pointer_field(pb_istream_t *stream, pb_wire_type_
             }
             else
             {
-                /* Normal repeated field, i.e. only one item at a time. */
+                /* Normal repeated field, i.e. only one item at a time.
+                 * Storage grows geometrically, so a field with n entries is
+                 * reallocated O(log n) times rather than once per entry. */
                 pb_size_t *size = (pb_size_t*)iter->pSize;
                 void *pItem;
                 
                 if (*size == PB_SIZE_MAX)
                     PB_RETURN_ERROR(stream, "too many array entries");
                 
-                if (!allocate_field(stream, iter->pData, iter->pos->data_size, (size_t)(*size + 1)))
-                    return false;
+                if (pb_array_capacity((size_t)*size + 1) > pb_array_capacity(*size))
+                {
+                    if (!allocate_field(stream, iter->pData, iter->pos->data_size,
+                                        pb_array_capacity((size_t)*size + 1)))
+                        return false;
+                }
             
                 pItem = *(char**)iter->pData + iter->pos->data_size * (*size);
                 (*size)++;